@@ -0,0 +1,521 @@
+#ifndef AdaptiveRayIntersectableCircle_h
+#define AdaptiveRayIntersectableCircle_h
+
+#include <algorithm>
+
+#include <DGtal/base/Common.h>
+
+#include "IntegerHelpers.h"
+#include "Integer256.h"
+#include "ExactRayIntersectableCircle.h"
+
+/**
+ * Class implementing a circle that is 'ray intersectable',
+ * like ExactRayIntersectableCircle, but whose computations
+ * are performed with the narrowest integer type among
+ * machine integers, 128-bit integers and 256-bit integers
+ * that is guaranteed not to overflow.
+ *
+ * The circle parameters are given as DGtal::BigInteger.
+ * At construction, the parameters are normalized (see
+ * ExactRayIntersectableCircle::normalize), so that their size
+ * does not depend on the location of the circle, the number 
+ * of bits of the parameters is computed and the parameters 
+ * are stored in each integer type that is able to represent them.
+ * Then, at each call, the number of bits of the intermediate
+ * values is bounded from the number of bits of the input
+ * point and direction and the computation is delegated
+ * to the circle of the narrowest suitable integer type.
+ * DGtal::BigInteger is used as a last resort, so that
+ * the results are always exact and equal to the ones
+ * of ExactRayIntersectableCircle.
+ *
+ * @tparam TPoint a model of point/vector.
+ *
+ * This class is a model of point functor and of ray intersectable shape
+ */
+template <typename TPoint>
+class AdaptiveRayIntersectableCircle
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TPoint Point;
+  typedef TPoint Vector;
+  typedef typename TPoint::Coordinate Coordinate;
+  typedef DGtal::BigInteger Integer;
+  /**
+   * Only the sign of the function is returned
+   */
+  typedef int Value;
+
+  typedef ExactRayIntersectableCircle<Point, long long int> Circle64;
+  typedef ExactRayIntersectableCircle<Point, Int128> Circle128;
+  typedef ExactRayIntersectableCircle<Point, Integer256> Circle256;
+  typedef ExactRayIntersectableCircle<Point, Integer> CircleBig;
+
+private:
+  /////////////////////// members /////////////////////
+  /**
+   * The same circle for each integer type.
+   * A circle is valid only if its parameters
+   * can be represented in its integer type.
+   */
+  Circle64 myCircle64;
+  Circle128 myCircle128;
+  Circle256 myCircle256;
+  CircleBig myCircle;
+
+  /**
+   * Number of bits of the circle parameters
+   * (a and b together, c, d), of the coordinates
+   * of the center and of the diameter
+   */
+  int myBitsAB, myBitsC, myBitsD, myBitsCenter, myBitsDiameter;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Default constructor
+   */
+  AdaptiveRayIntersectableCircle()
+    : myCircle64(), myCircle128(), myCircle256(), myCircle()
+  {
+    init();
+  }
+
+  /**
+   * Standard constructor
+   * @param a a-parameter
+   * @param b b-parameter
+   * @param c c-parameter
+   * @param d d-parameter
+   */
+  AdaptiveRayIntersectableCircle(const Integer& a, const Integer& b, const Integer& c, const Integer& d)
+    : myCircle(a, b, c, d)
+  {
+    init();
+  }
+
+  /**
+   * Constructor from three points
+   * @param aP first point
+   * @param aQ second point
+   * @param aR third point
+   */
+  AdaptiveRayIntersectableCircle(const Point& aP, const Point& aQ, const Point& aR)
+    : myCircle(aP, aQ, aR)
+  {
+    init();
+  }
+
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  AdaptiveRayIntersectableCircle(const AdaptiveRayIntersectableCircle& other)
+    : myCircle64(other.myCircle64), myCircle128(other.myCircle128),
+      myCircle256(other.myCircle256), myCircle(other.myCircle),
+      myBitsAB(other.myBitsAB), myBitsC(other.myBitsC), myBitsD(other.myBitsD),
+      myBitsCenter(other.myBitsCenter), myBitsDiameter(other.myBitsDiameter) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  AdaptiveRayIntersectableCircle& operator=(const AdaptiveRayIntersectableCircle& other)
+  {
+    if (&other != this)
+      {
+	myCircle64 = other.myCircle64;
+	myCircle128 = other.myCircle128;
+	myCircle256 = other.myCircle256;
+	myCircle = other.myCircle;
+	myBitsAB = other.myBitsAB;
+	myBitsC = other.myBitsC;
+	myBitsD = other.myBitsD;
+	myBitsCenter = other.myBitsCenter;
+	myBitsDiameter = other.myBitsDiameter;
+      }
+    return *this;
+  }
+
+  /**
+   * Default destructor
+   */
+  ~AdaptiveRayIntersectableCircle() {}
+
+private:
+  /**
+   * Computes the number of bits of the parameters
+   * and copies the parameters in each integer type
+   * that is able to represent them.
+   */
+  void init()
+  {
+    typedef IntegerTraits<Integer> Traits;
+    myCircle.normalize(); 
+    Integer a = myCircle.a(), b = myCircle.b(), c = myCircle.c(), d = myCircle.d();
+    Point shift = myCircle.getShift(); 
+
+    myBitsAB = std::max( Traits::bitLength(a), Traits::bitLength(b) );
+    myBitsC = Traits::bitLength(c);
+    myBitsD = Traits::bitLength(d);
+    int bits = std::max( std::max(myBitsAB, myBitsC), myBitsD );
+
+    if (c != 0)
+      {
+	Integer c2 = 2*abs(c);
+	//upper bound of the center coordinates
+	Integer center = (abs(a) + abs(b)) / c2 + 1;
+	myBitsCenter = Traits::bitLength(center);
+	//upper bound of the diameter used in ray casting
+	Integer r2 = abs(a*a + b*b - 4*c*d) / (c2*c2);
+	Integer diameter = 2*(sqrt(r2) + 2) + 1;
+	myBitsDiameter = Traits::bitLength(diameter);
+      }
+    else
+      { //degenerated circle
+	myBitsCenter = myBitsDiameter = 0;
+      }
+
+    if (bits < 63)
+      myCircle64 = Circle64( Traits::castToInt64(a), Traits::castToInt64(b),
+			     Traits::castToInt64(c), Traits::castToInt64(d), shift );
+    if (bits < 127)
+      myCircle128 = Circle128( Traits::castToInt128(a), Traits::castToInt128(b),
+			       Traits::castToInt128(c), Traits::castToInt128(d), shift );
+    if (bits < 255)
+      myCircle256 = Circle256( toInteger256(a), toInteger256(b),
+			       toInteger256(c), toInteger256(d), shift );
+  }
+
+  /**
+   * @param x any integer of less than 255 bits
+   * @return @a x as a 256-bit integer
+   */
+  static Integer256 toInteger256(const Integer& x)
+  {
+    Integer m = abs(x);
+    Integer256 res(0);
+    for (int i = 3; i >= 0; i--)
+      {
+	Integer l = m >> (64*i);
+	res = (res << 64) + Integer256( (Int128) mpz_get_ui(l.get_mpz_t()) );
+      }
+    return ( (sgn(x) < 0)?( -res ):( res ) );
+  }
+
+  /**
+   * @param aPoint any point
+   * @return number of bits of the largest coordinate
+   * of the point in the local frame of the parameters
+   */
+  int localBitLength(const Point& aPoint) const
+  {
+    return bitLength( aPoint - myCircle.getShift() ); 
+  }
+
+  /**
+   * @param aPoint any point or vector
+   * @return number of bits of its largest coordinate
+   */
+  static int bitLength(const Point& aPoint)
+  {
+    typedef IntegerTraits<Coordinate> Traits;
+    return std::max( Traits::bitLength(aPoint[0]), Traits::bitLength(aPoint[1]) );
+  }
+
+  /**
+   * @param aBits number of bits of the coordinates of a point
+   * @return upper bound of the number of bits of the
+   * intermediate values involved in the evaluation of
+   * the function at this point
+   */
+  int evaluationBits(const int& aBits) const
+  {
+    return std::max( std::max(myBitsAB + aBits, myBitsC + 2*aBits + 1), myBitsD ) + 2;
+  }
+
+  /**
+   * @param aStartBits number of bits of the coordinates of
+   * the source of a ray
+   * @param aDirBits number of bits of the coordinates of
+   * the direction of a ray
+   * @return upper bound of the number of bits of the
+   * intermediate values involved in the ray casting
+   */
+  int rayCastingBits(const int& aStartBits, const int& aDirBits) const
+  {
+    int aEqBits = myBitsC + 2*aDirBits + 1;
+    int bEqBits = std::max(myBitsAB + aDirBits, myBitsC + aStartBits + aDirBits + 1) + 2;
+    int cEqBits = evaluationBits(aStartBits);
+    int deltaBits = std::max(2*bEqBits, aEqBits + cEqBits + 2) + 1;
+    //the points evaluated along the ray lie between the source
+    //and either the vertex of the parabola or the opposite side
+    //of the circle
+    int pointBits = std::max( std::max(aStartBits, myBitsCenter),
+			      myBitsDiameter + aDirBits ) + 3;
+    return std::max( deltaBits, evaluationBits(pointBits) );
+  }
+
+public:
+  ///////////////////// read access ///////////////////
+  /**
+   * Origin of the local frame accessor
+   * @return the point that the parameters are relative to
+   */
+  Point getShift() const { return myCircle.getShift(); }
+
+  /**
+   * a-parameter accessor (in the local frame)
+   * @return a-parameter.
+   */
+  Integer a() const { return myCircle.a(); }
+
+  /**
+   * b-parameter accessor (in the local frame)
+   * @return b-parameter.
+   */
+  Integer b() const { return myCircle.b(); }
+
+  /**
+   * c-parameter accessor (in the local frame)
+   * @return c-parameter.
+   */
+  Integer c() const { return myCircle.c(); }
+
+  /**
+   * d-parameter accessor (in the local frame)
+   * @return d-parameter.
+   */
+  Integer d() const { return myCircle.d(); }
+
+  /**
+   * radius accessor
+   * @return circle radius
+   */
+  double getRadius() const { return myCircle.getRadius(); }
+
+  /**
+   * center x-coordinate accessor
+   * @return x-coordinate of the circle center.
+   */
+  double getCenterX() const { return myCircle.getCenterX(); }
+
+  /**
+   * center y-coordinate accessor
+   * @return y-coordinate of the circle center.
+   */
+  double getCenterY() const { return myCircle.getCenterY(); }
+
+  /**
+   * Returns the minimal y-coordinate of the digital points
+   * lying inside the circle.
+   * @return minimal y-coordinate.
+   */
+  Coordinate getBottom() const { return myCircle.getBottom(); }
+
+public:
+  ///////////////////// main methods ///////////////////
+  /**
+   * Function operator
+   * @param aPoint any point
+   * @return 0 if @a aPoint is on the circle,
+   * -1 if @a aPoint is outside
+   * 1 if @a aPoint is inside
+   */
+  Value operator()(const Point& aPoint) const
+  {
+    int bits = evaluationBits( localBitLength(aPoint) );
+    if (bits < 63)
+      return sign( myCircle64(aPoint) );
+    else if (bits < 127)
+      return sign( myCircle128(aPoint) );
+    else if (bits < 255)
+      return sign( myCircle256(aPoint) );
+    else
+      return sign( myCircle(aPoint) );
+  }
+
+  /**
+   * Class implementing a cursor moving along a digital ray, 
+   * which delegates the finite differences to the cursor 
+   * of the circle of the narrowest suitable integer type. 
+   * NB: the integer type is chosen as for ray casting, 
+   * so that the cursor is valid as long as it is only moved 
+   * to points lying inside the circle or on the circle. 
+   */
+  class RayCursor
+  {
+  private: 
+    /////////////////////// members /////////////////////
+    int myBits;                               /* bound on the number of bits */
+    typename Circle64::RayCursor myCursor64;  /* cursors of each integer type */
+    typename Circle128::RayCursor myCursor128; 
+    typename Circle256::RayCursor myCursor256; 
+    typename CircleBig::RayCursor myCursor; 
+
+  public:
+    ///////////////////// standard services /////////////
+    /**
+     * Standard constructor
+     * @param aCircle circle
+     * @param aPoint any point
+     * @param aDirection ray direction
+     */
+    RayCursor(const AdaptiveRayIntersectableCircle& aCircle, 
+	      const Point& aPoint, const Vector& aDirection)
+      : myBits( aCircle.rayCastingBits( aCircle.localBitLength(aPoint), bitLength(aDirection) ) )
+    {
+      if (myBits < 63)
+	myCursor64 = aCircle.myCircle64.cursor(aPoint, aDirection); 
+      else if (myBits < 127)
+	myCursor128 = aCircle.myCircle128.cursor(aPoint, aDirection); 
+      else if (myBits < 255)
+	myCursor256 = aCircle.myCircle256.cursor(aPoint, aDirection); 
+      else
+	myCursor = aCircle.myCircle.cursor(aPoint, aDirection); 
+    }
+
+    ///////////////////// main methods ///////////////////
+    /**
+     * @return current point
+     */
+    const Point& point() const 
+    {
+      if (myBits < 63)
+	return myCursor64.point(); 
+      else if (myBits < 127)
+	return myCursor128.point(); 
+      else if (myBits < 255)
+	return myCursor256.point(); 
+      else
+	return myCursor.point(); 
+    }
+
+    /**
+     * @return sign of the value at the current point
+     */
+    Value value() const 
+    {
+      if (myBits < 63)
+	return sign( myCursor64.value() ); 
+      else if (myBits < 127)
+	return sign( myCursor128.value() ); 
+      else if (myBits < 255)
+	return sign( myCursor256.value() ); 
+      else
+	return sign( myCursor.value() ); 
+    }
+
+    /**
+     * @return sign of the value at the next point along the ray
+     */
+    Value nextValue() const 
+    {
+      if (myBits < 63)
+	return sign( myCursor64.nextValue() ); 
+      else if (myBits < 127)
+	return sign( myCursor128.nextValue() ); 
+      else if (myBits < 255)
+	return sign( myCursor256.nextValue() ); 
+      else
+	return sign( myCursor.nextValue() ); 
+    }
+
+    /**
+     * Moves the cursor to the next point along the ray
+     */
+    void advance()
+    {
+      if (myBits < 63)
+	myCursor64.advance(); 
+      else if (myBits < 127)
+	myCursor128.advance(); 
+      else if (myBits < 255)
+	myCursor256.advance(); 
+      else
+	myCursor.advance(); 
+    }
+  }; 
+
+  /**
+   * @param aPoint any point
+   * @param aDirection ray direction
+   * @return cursor lying at @a aPoint and moving along @a aDirection
+   */
+  RayCursor cursor(const Point& aPoint, const Vector& aDirection) const
+  {
+    return RayCursor(*this, aPoint, aDirection); 
+  }
+
+  /**
+   * Intersection between the circle and the digital ray
+   *
+   * @param aStartingPoint point from which the ray is emanating
+   * @param aDirection ray direction
+   * @param returned maximal integer such that
+   * @a aStartingPoint + @a aQuotient * @a aDirection lies close
+   * (but on the same side) to the circle
+   * @param returned point equal to @a aStartingPoint + @a aQuotient * @a aDirection
+   *
+   * @return 'true' if the ray and the circle instercest, 'false' otherwise
+   * @see ExactRayIntersectableCircle::dray
+   */
+  bool dray(const Point& aStartingPoint, const Vector& aDirection,
+	    Coordinate& aQuotient, Point& aClosest) const
+  {
+    int bits = rayCastingBits( localBitLength(aStartingPoint), bitLength(aDirection) );
+    if (bits < 63)
+      return myCircle64.dray(aStartingPoint, aDirection, aQuotient, aClosest);
+    else if (bits < 127)
+      return myCircle128.dray(aStartingPoint, aDirection, aQuotient, aClosest);
+    else if (bits < 255)
+      return myCircle256.dray(aStartingPoint, aDirection, aQuotient, aClosest);
+    else
+      return myCircle.dray(aStartingPoint, aDirection, aQuotient, aClosest);
+  }
+
+  /**
+   * Returns a vertex of the convex hull of the digital points
+   * lying inside the circle, such that it has a minimal y-coordinate,
+   * and among the digital points of minimal y-coordinate, it has
+   * a maximal x-coordinate.
+   * @return vertex of the convex hull.
+   */
+  Point getConvexHullVertex() const { return myCircle.getConvexHullVertex(); }
+
+  /**
+   * Returns the four vertices of the convex hull that are 
+   * extremal in the axis directions, in a counter-clockwise order
+   * @param res output iterator that stores the four vertices
+   * @see ExactRayIntersectableCircle::getExtremalVertices
+   */
+  template <typename OutputIterator>
+  void getExtremalVertices(OutputIterator res) const { myCircle.getExtremalVertices(res); }
+
+  /**
+   * Returns a vertex of the convex hull that supports a given direction
+   * @param aNormal any non-zero vector
+   * @param aIsLast 'true' to return the last vertex of an edge
+   * orthogonal to @a aNormal, 'false' to return the first one
+   * @return vertex of the convex hull. 
+   * @see ExactRayIntersectableCircle::getSupportingVertex
+   */
+  Point getSupportingVertex(const Vector& aNormal, bool aIsLast = true) const 
+  { return myCircle.getSupportingVertex(aNormal, aIsLast); }
+
+private:
+  /**
+   * @param x any integer
+   * @return sign of @a x
+   */
+  template <typename T>
+  static Value sign(const T& x)
+  {
+    return (x > 0)?1:( (x < 0)?-1:0 );
+  }
+
+};
+#endif
@@ -0,0 +1,388 @@
+#ifndef AlphaSpectrum_h
+#define AlphaSpectrum_h
+
+#include<vector>
+#include<queue>
+#include<iterator>
+
+#include "BasicHelpers.h"
+#include "IntegerHelpers.h"
+#include "CircleTraits.h"
+#include "IncrementalNegativeAlphaShape.h"
+
+/**
+ * Class implementing an index of the negative alpha-shapes of
+ * all digital points lying inside a ray-intersectable shape,
+ * for all alphas at once.
+ *
+ * The alpha-shapes are nested: the vertices of the alpha-shape of
+ * radius r are the points of the boundary (the vertices of the
+ * alpha-shape of smallest radius, sqrt(2)/2, since no circle passes
+ * through three digital points with a smaller radius) whose critical
+ * radius is greater than r, together with the vertices of the convex
+ * hull. Indeed, the
+ * alpha-shape of radius r is obtained from the boundary by removing
+ * the reflex vertices b, of neighbors a and c, such that the radius
+ * of the circumcircle of abc is not greater than r, and, if r is
+ * infinite, the vertices lying on an edge (see closedGrahamScan).
+ * The critical radii are thus computed by a single sweep over the
+ * increasing radii, which removes the vertices in the order of the
+ * circumradius of their current neighbors, as a rational
+ * num2/den2 of the squared circumradius (den2 = 0 being an infinite
+ * radius).
+ *
+ * The points are stored in a Cartesian tree whose in-order is the
+ * counter-clockwise order and whose nodes are sorted like a heap by
+ * critical radius, so that a query only visits the vertices of
+ * its output and at most two other nodes per vertex.
+ *
+ * Basic usage:
+ * @code
+ AlphaSpectrum<Shape, Predicate> spectrum(shape);
+ std::vector<Point> v;
+ spectrum.alphaShape( Predicate(10, 2, false), std::back_inserter(v) );
+ * @endcode
+ *
+ * @tparam TShape a model of ray-intersectable shape.
+ * @tparam TPredicate a model of ternary predicate with a radius,
+ * like CircumcircleRadiusPredicate.
+ * @tparam TInteger a model of integer for the critical radii,
+ * ie. able to represent the product of three squared distances
+ * (DGtal::BigInteger by default).
+ */
+template <typename TShape, typename TPredicate, typename TInteger = DGtal::BigInteger>
+class AlphaSpectrum
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TShape Shape;
+  typedef typename Shape::Point Point;
+  typedef typename Point::Coordinate Coordinate;
+  typedef TPredicate Predicate;
+  typedef TInteger Integer;
+
+private:
+  /**
+   * Squared radius num2/den2 of the circumcircle
+   * of a vertex and its neighbors, when it is
+   * removed by the sweep
+   */
+  struct Event
+  {
+    Integer num2;
+    Integer den2;
+    std::size_t index;
+    unsigned int version;
+
+    /**
+     * @return 'true' if the radius is greater
+     * than the one of @a other (order of a min-heap)
+     */
+    bool operator<(const Event& other) const
+    {
+      return (num2*other.den2 > other.num2*den2);
+    }
+  };
+
+  /////////////////////// members /////////////////////
+  /**
+   * const reference on a shape
+   */
+  const Shape& myShape;
+
+  /**
+   * Points of the boundary, in a counter-clockwise order
+   * from the first vertex of the convex hull
+   */
+  std::vector<Point> myPoints;
+
+  /**
+   * Critical squared radius of each point: the point is
+   * a vertex of the alpha-shapes of smaller radius
+   */
+  std::vector<Integer> myNum2;
+  std::vector<Integer> myDen2;
+
+  /**
+   * 'true' for the vertices of the convex hull,
+   * which are vertices of all the alpha-shapes
+   */
+  std::vector<bool> myIsHullVertex;
+
+  /**
+   * Cartesian tree: root and children of each node
+   * (size of myPoints if none)
+   */
+  std::size_t myRoot;
+  std::vector<std::size_t> myLeft;
+  std::vector<std::size_t> myRight;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Standard constructor, which retrieves the boundary
+   * and computes the critical radii
+   * @param aShape any 'ray-intersectable' shape
+   */
+  AlphaSpectrum(const Shape& aShape)
+    : myShape(aShape)
+  {
+    //boundary: alpha-shape of radius sqrt(2)/2
+    Predicate predicate(1, 2, false);
+    IncrementalNegativeAlphaShape<Shape, Predicate> as(aShape, predicate);
+    as.all( std::back_inserter(myPoints) );
+    sweep();
+    build();
+  }
+
+private:
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  AlphaSpectrum(const AlphaSpectrum& other) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  AlphaSpectrum& operator=(const AlphaSpectrum& other)
+  { return *this; }
+
+public:
+  /**
+   * Default destructor
+   */
+  ~AlphaSpectrum() {}
+
+  /**
+   * @return number of points of the boundary
+   */
+  std::size_t size() const { return myPoints.size(); }
+
+  /**
+   * @return points of the boundary, in a counter-clockwise order
+   */
+  const std::vector<Point>& getPoints() const { return myPoints; }
+
+  /**
+   * Critical radius accessor
+   * @param i index of a point of the boundary
+   * @param aNum2 (returned) squared numerator
+   * @param aDen2 (returned) squared denominator (0 if infinite)
+   * @return 'true' if the point is a vertex of the
+   * convex hull, ie. of all the alpha-shapes
+   */
+  bool getCriticalRadius(std::size_t i, Integer& aNum2, Integer& aDen2) const
+  {
+    aNum2 = myNum2[i];
+    aDen2 = myDen2[i];
+    return myIsHullVertex[i];
+  }
+
+private:
+  /**
+   * Conversion of a coordinate into the integer type
+   * @param x any coordinate
+   * @return @a x as an integer of type Integer
+   */
+  static Integer toInteger(const Coordinate& x)
+  {
+    return IntegerTraits<Integer>::castFromInt64( IntegerTraits<Coordinate>::castToInt64(x) );
+  }
+
+  /**
+   * Computes the event of a vertex given its neighbors
+   * @param a previous vertex
+   * @param b vertex
+   * @param c next vertex
+   * @param aEvent (returned) squared circumradius of abc if b is
+   * a reflex vertex, infinite radius if it lies on the edge ac
+   * @return 'false' if b is a convex vertex, which is not removed
+   */
+  static bool event(const Point& a, const Point& b, const Point& c, Event& aEvent)
+  {
+    Integer ab0 = toInteger(b[0] - a[0]), ab1 = toInteger(b[1] - a[1]);
+    Integer bc0 = toInteger(c[0] - b[0]), bc1 = toInteger(c[1] - b[1]);
+    Integer ac0 = toInteger(c[0] - a[0]), ac1 = toInteger(c[1] - a[1]);
+    Integer area = ab0*ac1 - ab1*ac0;
+    if (area > 0)
+      return false;
+    if (area == 0)
+      {
+	aEvent.num2 = 1;
+	aEvent.den2 = 0;
+	return true;
+      }
+    aEvent.num2 = (ab0*ab0 + ab1*ab1)*(bc0*bc0 + bc1*bc1)*(ac0*ac0 + ac1*ac1);
+    aEvent.den2 = 4*area*area;
+    return true;
+  }
+
+  /**
+   * Removes the vertices of the boundary in the order of their
+   * squared circumradius, which is updated for their neighbors,
+   * and stores the current radius as their critical radius.
+   * The remaining vertices are the vertices of the convex hull.
+   */
+  void sweep()
+  {
+    std::size_t n = myPoints.size();
+    myNum2.assign(n, Integer(1));
+    myDen2.assign(n, Integer(0));
+    myIsHullVertex.assign(n, true);
+    std::vector<std::size_t> prev(n), next(n);
+    std::vector<unsigned int> versions(n, 0);
+    std::priority_queue<Event> events;
+    for (std::size_t i = 0; i < n; i++)
+      {
+	prev[i] = (i + n - 1) % n;
+	next[i] = (i + 1) % n;
+      }
+    for (std::size_t i = 0; i < n; i++)
+      {
+	Event e;
+	e.index = i;
+	e.version = 0;
+	if (event(myPoints[prev[i]], myPoints[i], myPoints[next[i]], e))
+	  events.push(e);
+      }
+
+    Integer num2 = 0, den2 = 1; //current radius
+    std::size_t nbVertices = n;
+    while ( (!events.empty()) && (nbVertices > 3) )
+      {
+	Event e = events.top();
+	events.pop();
+	std::size_t i = e.index;
+	if (e.version != versions[i])
+	  continue;
+	//the radius does not decrease
+	if (e.num2*den2 > num2*e.den2)
+	  {
+	    num2 = e.num2;
+	    den2 = e.den2;
+	  }
+	myNum2[i] = num2;
+	myDen2[i] = den2;
+	myIsHullVertex[i] = false;
+	versions[i]++;
+	nbVertices--;
+
+	//update of the neighbors
+	std::size_t a = prev[i], c = next[i];
+	next[a] = c;
+	prev[c] = a;
+	std::size_t neighbors[2] = {a, c};
+	for (int k = 0; k < 2; k++)
+	  {
+	    std::size_t j = neighbors[k];
+	    versions[j]++;
+	    Event f;
+	    f.index = j;
+	    f.version = versions[j];
+	    if (event(myPoints[prev[j]], myPoints[j], myPoints[next[j]], f))
+	      events.push(f);
+	  }
+      }
+  }
+
+  /**
+   * @param i index of a point
+   * @param j index of a point
+   * @return 'true' if the critical radius of the i-th point
+   * is smaller than the one of the j-th point
+   */
+  bool isSmaller(std::size_t i, std::size_t j) const
+  {
+    if (myIsHullVertex[i] != myIsHullVertex[j])
+      return myIsHullVertex[j];
+    return (myNum2[i]*myDen2[j] < myNum2[j]*myDen2[i]);
+  }
+
+  /**
+   * Builds the Cartesian tree of the points
+   * (stack-based construction in linear time)
+   */
+  void build()
+  {
+    std::size_t n = myPoints.size();
+    myLeft.assign(n, n);
+    myRight.assign(n, n);
+    std::vector<std::size_t> stack;
+    for (std::size_t i = 0; i < n; i++)
+      {
+	std::size_t last = n;
+	while ( (!stack.empty()) && (isSmaller(stack.back(), i)) )
+	  {
+	    last = stack.back();
+	    stack.pop_back();
+	  }
+	myLeft[i] = last;
+	if (!stack.empty())
+	  myRight[stack.back()] = i;
+	stack.push_back(i);
+      }
+    myRoot = (stack.empty())?n:stack.front();
+  }
+
+public:
+  ///////////////////// main methods ///////////////////
+  /**
+   * Retrieves the vertices of the alpha-shape of a given radius
+   * in a counter-clockwise order, from the vertex of the convex
+   * hull of minimal y-coordinate (and maximal x-coordinate among
+   * them), like IncrementalNegativeAlphaShape::all
+   * (the radius is assumed to be at least sqrt(2)/2)
+   *
+   * @param aNum2 squared numerator of the radius
+   * @param aDen2 squared denominator of the radius (0 if infinite)
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void alphaShape(const Integer& aNum2, const Integer& aDen2, OutputIterator res) const
+  {
+    std::size_t n = myPoints.size();
+    //in-order traversal of the nodes that are vertices,
+    //the descendants of the other ones being not
+    std::vector<std::size_t> stack;
+    std::size_t i = myRoot;
+    while ( (i != n) || (!stack.empty()) )
+      {
+	if ( (i != n) && ( (myIsHullVertex[i]) || (aNum2*myDen2[i] < myNum2[i]*aDen2) ) )
+	  {
+	    stack.push_back(i);
+	    i = myLeft[i];
+	  }
+	else
+	  {
+	    if (stack.empty())
+	      return;
+	    i = stack.back();
+	    stack.pop_back();
+	    *res++ = myPoints[i];
+	    i = myRight[i];
+	  }
+      }
+  }
+
+  /**
+   * Retrieves the vertices of the alpha-shape of the radius
+   * of a given predicate (see above)
+   *
+   * @param aPredicate any predicate of negative sign, whose
+   * radius fits in type Integer (any radius if Integer is
+   * DGtal::BigInteger)
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void alphaShape(const Predicate& aPredicate, OutputIterator res) const
+  {
+    //lossless conversion of the radius
+    typedef IntegerConversion<Integer, typename Predicate::Integer> Conversion;
+    alphaShape( Conversion::cast(aPredicate.getNum2()), Conversion::cast(aPredicate.getDen2()), res );
+  }
+
+};
+#endif
@@ -2,10 +2,15 @@
 #define BottomUpPositiveAlphaShape_h
 
 #include<cmath>
+#include<deque>
+#include<iterator>
+#include<algorithm>
 
 #include"CircumcircleRadiusPredicate.h"
+#include "IntegerHelpers.h"
 
 #include "ConvexHullHelpers.h"
+#include "OutputSensitiveConvexHull.h"
 
 /**
  * Class implementing an on-line and ouput-sensitive algorithm
@@ -15,9 +20,12 @@
  * a ray emanating from a given point along a given direction
  * is computable.
  *
- * @tparam TShape a model of ray-intersectable shape.
- * @tparam TPredicate a model of ternary predicate: 
- * given three points, the operator() returns a bool.  
+ * @tparam TShape a model of ray-intersectable circle, 
+ * whose center and radius are given by getCenterX(), 
+ * getCenterY() and getRadius(). 
+ * @tparam TPredicate a model of ternary predicate with a radius,
+ * like CircumcircleRadiusPredicate: given three points, 
+ * the operator() returns a bool.  
  */
 template <typename TShape, typename TPredicate>
 class BottomUpPositiveAlphaShape
@@ -27,6 +35,7 @@ class BottomUpPositiveAlphaShape
     typedef TShape Shape;
     typedef typename Shape::Point Point;
     typedef typename Shape::Vector Vector; //type redefinition
+    typedef typename Point::Coordinate Coordinate;
     typedef TPredicate Predicate;
     typedef std::deque<Point> Container;
 
@@ -44,6 +53,19 @@ class BottomUpPositiveAlphaShape
      * NB. alpha is implicitely defined by the predicate. 
      */
     const Predicate& myPredicate; 
+    /**
+     * Squared radius of the predicate as a fraction,
+     * used to check that the vertices are final
+     */
+    double myNum2; 
+    double myDen2; 
+    /**
+     * Center and radius of the shape, 
+     * used to check that the vertices are final
+     */
+    double myCenterX; 
+    double myCenterY; 
+    double myRadius; 
 
   public:
     ///////////////////// standard services /////////////
@@ -53,7 +75,10 @@ class BottomUpPositiveAlphaShape
      * @param aPredicate any predicate
      */
     BottomUpPositiveAlphaShape(const Shape& aShape, const Predicate& aPredicate)
-      : myShape(aShape), myPredicate(aPredicate) {}
+      : myShape(aShape), myPredicate(aPredicate), 
+        myNum2( IntegerTraits<typename Predicate::Integer>::castToDouble(aPredicate.getNum2()) ), 
+        myDen2( IntegerTraits<typename Predicate::Integer>::castToDouble(aPredicate.getDen2()) ), 
+        myCenterX( aShape.getCenterX() ), myCenterY( aShape.getCenterY() ), myRadius( aShape.getRadius() ) {}
 
   private:
     /**
@@ -86,6 +111,203 @@ class BottomUpPositiveAlphaShape
     ~BottomUpPositiveAlphaShape() {}
 
 
+  private:
+    /**
+     * @param x any coordinate
+     * @return @a x as a 128-bit integer
+     */
+    static Int128 toInt128(const Coordinate& x)
+    {
+      return IntegerTraits<Coordinate>::castToInt128(x);
+    }
+
+    /**
+     * @param x any 128-bit integer
+     * @return (rounded) value of @a x as a double
+     */
+    static double toDouble(const Int128& x)
+    {
+      return IntegerTraits<Int128>::castToDouble(x);
+    }
+
+    /**
+     * Checks that a vertex Q of the stack, lying just above a final
+     * vertex R, which is not the starting point, is final, ie. that
+     * it will not be removed by any remaining vertex of the convex
+     * hull (the vertices after @a aCurrent, the starting point
+     * included).
+     *
+     * A vertex N lying on the left of [R,Q], like the remaining
+     * vertices, removes Q if and only if the radius of the circle RQN
+     * is greater than r, ie. if N does not lie in the lune made up
+     * with the disc of radius r going through R and Q whose center
+     * is on the left of [R,Q], without the disc of radius r going
+     * through R and Q whose center is on the right of [R,Q].
+     * The remaining vertices are digital points of the shape lying
+     * in the region bounded by the segment going from @a aCurrent
+     * to @a aStartingPoint and the supporting lines of the edges
+     * ending at @a aCurrent and starting at @a aStartingPoint:
+     * - the part of the second disc lying on the left of [R,Q],
+     * whose height is at most |RQ|^2/4r, must lie on the left
+     * of the segment;
+     * - the part of the shape lying in the region must lie in the
+     * first disc. Since the power of a point with respect to this disc
+     * is a convex function, it is enough to check the corners of
+     * the region, the points where its sides leave the shape and the
+     * farthest point of the shape from the center of the disc if it
+     * lies in the region.
+     *
+     * The determinants are exactly computed with 128-bit integers,
+     * but the other quantities are computed with doubles and the
+     * tests only succeed if the slack is greater than a bound of the
+     * rounding errors, so that no vertex is wrongly proved to be final.
+     *
+     * @param aR final vertex of the stack
+     * @param aQ next vertex of the stack
+     * @param aPrevious vertex of the convex hull before @a aCurrent
+     * @param aCurrent last vertex of the convex hull given to the stack
+     * @param aStartingPoint starting vertex
+     * @param aSecond vertex of the convex hull after @a aStartingPoint
+     * @return 'true' if @a aQ is proved to be final, 'false' otherwise
+     */
+    bool isFinal(const Point& aR, const Point& aQ, 
+                 const Point& aPrevious, const Point& aCurrent, 
+                 const Point& aStartingPoint, const Point& aSecond) const
+    {
+      if (!myPredicate.getSign())
+        return false; 
+      //the remaining vertices lie on the left of [aR,aQ]
+      //and the lune is a half-plane for an infinite radius
+      if (myDen2 == 0)
+        return true; 
+      //aQ, lying on the boundary of the first disc, is not final
+      //before the next vertex is known
+      if (aQ == aCurrent)
+        return false; 
+
+      Int128 c0 = toInt128(aCurrent[0]), c1 = toInt128(aCurrent[1]); 
+      Int128 s0 = toInt128(aStartingPoint[0]), s1 = toInt128(aStartingPoint[1]); 
+      Int128 r0 = toInt128(aR[0]) - c0, r1 = toInt128(aR[1]) - c1; 
+      Int128 e0 = toInt128(aQ[0]) - toInt128(aR[0]), e1 = toInt128(aQ[1]) - toInt128(aR[1]); 
+      Int128 d0 = s0 - c0, d1 = s1 - c1; 
+      double l2 = toDouble(e0*e0 + e1*e1); 
+      if (4*myNum2 <= myDen2*l2*(1 + 1e-9))
+        return false; 
+
+      //outside the second disc: the corners R + h n and Q + h n,
+      //where n is the left normal of [R,Q] divided by |RQ| and
+      //h = |RQ|^2/4r, lie on the left of [aCurrent, aStartingPoint]
+      Int128 dot = d0*e0 + d1*e1; 
+      if (dot < 0)
+        {
+          Int128 dr = d0*r1 - d1*r0; 
+          Int128 dq = dr + d0*e1 - d1*e0; 
+          double dm = toDouble( (dr < dq)?dr:dq ); 
+          double k = toDouble(dot); 
+          if ( (dm <= 0) || (l2*k*k*myDen2 >= 16*myNum2*dm*dm*(1 - 1e-9)) )
+            return false; 
+        }
+
+      //the region is bounded by the segment from aCurrent to
+      //aStartingPoint, the ray going from aCurrent along u and the
+      //ray going from aStartingPoint along -v, which cross at
+      //aCurrent + (t/w) u = aStartingPoint - (z/w) v if they do
+      Int128 u0 = c0 - toInt128(aPrevious[0]), u1 = c1 - toInt128(aPrevious[1]); 
+      Int128 v0 = toInt128(aSecond[0]) - s0, v1 = toInt128(aSecond[1]) - s1; 
+      Int128 w = u0*v1 - u1*v0; 
+      Int128 t = d0*v1 - d1*v0; 
+      Int128 z = u0*d1 - u1*d0; 
+      bool isBounded = ( (w > 0) && (t > 0) && (z > 0) ); 
+
+      //inside the first disc: in the frame centered at the middle M
+      //of [R,Q], whose left normal n has norm L, the center is s n,
+      //with s = sqrt(4r^2 - L^2)/2L (see isInside)
+      double n0 = - toDouble(e1), n1 = toDouble(e0); 
+      double l = std::sqrt( l2 ); 
+      double s = std::sqrt( myNum2 / (myDen2*l2) - 0.25 ); 
+      double x[2] = { - toDouble(r0) - n1/2, - toDouble(r1) + n0/2 }; 
+      double y[2] = { x[0] + toDouble(d0), x[1] + toDouble(d1) }; 
+      double o0 = myCenterX - toDouble(c0) + x[0], o1 = myCenterY - toDouble(c1) + x[1]; 
+      double rho = myRadius; 
+      //bound of the rounding errors on the positions, which are
+      //relative to the coordinates, provided that the center and
+      //the radius of the shape are accurate up to a few ulps
+      double eps = 1e-11 * ( std::abs(myCenterX) + std::abs(myCenterY) + rho + l + 1 ); 
+
+      if ( (!isInside(x[0], x[1], n0, n1, l, s, eps)) 
+           || (!isInside(y[0], y[1], n0, n1, l, s, eps)) )
+        return false; 
+      //points where the rays leave the shape (or their crossing point)
+      double dir[2][2] = { { toDouble(u0), toDouble(u1) }, { - toDouble(v0), - toDouble(v1) } }; 
+      double* from[2] = { x, y }; 
+      for (int i = 0; i < 2; i++)
+        {
+          double a = dir[i][0]*dir[i][0] + dir[i][1]*dir[i][1]; 
+          double b = dir[i][0]*(from[i][0] - o0) + dir[i][1]*(from[i][1] - o1); 
+          double c = (from[i][0] - o0)*(from[i][0] - o0) 
+            + (from[i][1] - o1)*(from[i][1] - o1) - rho*rho; 
+          //positive root of a h^2 + 2b h + c, without cancellation
+          double delta = std::sqrt( std::max(0.0, b*b - a*c) ); 
+          double h = (b > 0)?( std::max(0.0, -c) / (b + delta) ):( (delta - b) / a ); 
+          if (isBounded)
+            h = std::min( h, toDouble( (i == 0)?t:z ) / toDouble(w) ); 
+          if (!isInside(from[i][0] + h*dir[i][0], from[i][1] + h*dir[i][1], n0, n1, l, s, eps))
+            return false; 
+        }
+
+      //farthest point of the shape from the center
+      double f0 = o0 - s*n0, f1 = o1 - s*n1; 
+      double f = std::sqrt( f0*f0 + f1*f1 ); 
+      if (f > 0)
+        {
+          f0 = o0 + rho*f0/f; 
+          f1 = o1 + rho*f1/f; 
+        }
+      else
+        {
+          f0 = o0 + rho; 
+          f1 = o1; 
+        }
+      //it is enough that it lies surely outside the region
+      double side[3][2] = { { x[0] - y[0], x[1] - y[1] }, { dir[0][0], dir[0][1] }, { dir[1][0], dir[1][1] } }; 
+      double* origin[3] = { x, x, y }; 
+      for (int i = 0; i < 3; i++)
+        {
+          double area = side[i][0]*(f1 - origin[i][1]) - side[i][1]*(f0 - origin[i][0]); 
+          if ( area < - eps*std::sqrt( side[i][0]*side[i][0] + side[i][1]*side[i][1] ) )
+            return true; 
+        }
+      return isInside(f0, f1, n0, n1, l, s, eps); 
+    }
+
+    /**
+     * Checks that a point, given with doubles in a frame centered at
+     * the middle of the segment [R,Q], lies inside the disc going
+     * through R and Q whose center is s n, where n is the left
+     * normal of [R,Q], of norm L, ie. that its power
+     * g(p) = |p|^2 - L^2/4 - 2s <p, n> is negative, with a slack
+     * greater than a bound of the rounding errors.
+     * @param p0 first coordinate of the point
+     * @param p1 second coordinate of the point
+     * @param n0 first coordinate of n
+     * @param n1 second coordinate of n
+     * @param l norm L of n
+     * @param s ratio between the distance from the center to
+     * the origin and L
+     * @param eps bound of the rounding errors on the positions
+     * @return 'true' if the point is proved to be inside,
+     * 'false' otherwise
+     */
+    static bool isInside(double p0, double p1, double n0, double n1, 
+                         double l, double s, double eps)
+    {
+      double p = std::sqrt( p0*p0 + p1*p1 ); 
+      double g = p*p - l*l/4 - 2*s*(p0*n0 + p1*n1); 
+      //the gradient of g is bounded by twice the sum of the
+      //distance to the center and the radius
+      return ( g < -eps*(2*p + 2*s*l + l + eps) ); 
+    }
+
     ///////////////////// main methods ///////////////////
   public:
 
@@ -115,39 +337,73 @@ class BottomUpPositiveAlphaShape
 
     }
 
-     /**
+    /**
      * Retrieves all the vertices of the alpha-shape
-     * in a counter-clockwise order from a given vertex
-     *  
+     * in a counter-clockwise order from a given vertex.
+     * The vertices of the convex hull are given one by one
+     * to the stack of the alpha-shape, without being stored,
+     * and the vertices of the stack are written and removed
+     * from the stack as soon as they are proved to be final:
+     * the starting point at once, since it is never removed,
+     * and any other vertex once the next one is proved to be
+     * final (see isFinal), since it cannot be removed before. 
+     * The stack only keeps the last written vertex and the
+     * vertices that are not final yet, which are a few ones
+     * unless the radius is very close to the radius of the shape.
+     *
      * @param aStartingPoint a vertex of the alpha-shape
      * @param res output iterator that stores the sequence of vertices
      */
-
-    template <typename Container, typename Point>
-      void all(Container& res, Point aStartingPoint)
+    template <typename OutputIterator>
+      void all(const Point& aStartingPoint, OutputIterator res)
       {
-        // Retrieve the convex hull vertices
         OutputSensitiveConvexHull<TShape> ch(myShape);
-        std::vector<Point> resCH;
-        ch.all(aStartingPoint, std::back_inserter(resCH), false);
-
-        typename std::vector<Point>::iterator it = resCH.begin();
-        //auto it = resCH.begin(); // c++ 11
-        Point tmp = *it;
-                
-        do{
-          
-          // add the next alpha-shape vertices
-          next(tmp, res);
-          tmp = *it;
+        //last written vertex, followed by the vertices
+        //that are not final yet
+        Container container;
+
+        //the starting point is final
+        next(aStartingPoint, container);
+        *res++ = aStartingPoint;
 
-          //while it is not the first one
-        }while (it++ != resCH.end());
+        Point second = ch.next(aStartingPoint);
+        Point previous = aStartingPoint;
+        Point tmp = second;
+        while (tmp != aStartingPoint)
+        {
+          // add the next alpha-shape vertices
+          next(tmp, container);
+          // write the vertices whose next one is final
+          while ( (container.size() > 2)
+                  && (isFinal(container[1], container[2], previous, tmp, aStartingPoint, second)) )
+          {
+            container.pop_front();
+            *res++ = container.front();
+          }
+          previous = tmp;
+          tmp = ch.next(tmp);
+        }
 
         //maintaining convexity with the starting point
-        updateConvexHull(res, aStartingPoint, myPredicate);
+        if (container.size() > 1)
+          updateConvexHull(container, aStartingPoint, myPredicate);
+        std::copy(container.begin() + 1, container.end(), res);
       }//end proc
 
+    /**
+     * Retrieves all the vertices of the alpha-shape
+     * in a counter-clockwise order from a given vertex
+     * (see above)
+     *
+     * @param res (returned) container of the vertices
+     * @param aStartingPoint a vertex of the alpha-shape
+     */
+    template <typename OtherContainer>
+      void all(OtherContainer& res, const Point& aStartingPoint)
+      {
+        all(aStartingPoint, std::back_inserter(res));
+      }
+
 
 }; 
 #endif
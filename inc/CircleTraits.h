@@ -0,0 +1,221 @@
+#ifndef CircleTraits_h
+#define CircleTraits_h
+
+#include "IntegerHelpers.h"
+#include "Integer256.h"
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Narrowest integer type able to represent any integer
+ * of absolute value less than 2^@a Bits:
+ * long long if @a Bits <= 63, Int128 if @a Bits <= 127
+ * and Integer256 if @a Bits <= 255.
+ * The instantiation fails at compile time otherwise.
+ *
+ * @tparam Bits number of bits (sign excluded)
+ */
+template <int Bits, bool IsInt64 = (Bits <= 63), bool IsInt128 = (Bits <= 127)>
+struct BoundedInteger
+{
+  static_assert( Bits <= 255, "BoundedInteger: no integer type wide enough" );
+  typedef Integer256 Type;
+};
+
+template <int Bits>
+struct BoundedInteger<Bits, false, true>
+{
+  typedef Int128 Type;
+};
+
+template <int Bits>
+struct BoundedInteger<Bits, true, true>
+{
+  typedef long long Type;
+};
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Conversion between two integer types,
+ * which is the identity if the types are the same
+ * (so that no copy of dynamically allocated integers is made).
+ * NB: the value must fit in type @a TTo.
+ *
+ * @tparam TTo target type
+ * @tparam TFrom source type
+ */
+template <typename TTo, typename TFrom>
+struct IntegerConversion
+{
+  static TTo cast(const TFrom& x) { return TTo(x); }
+};
+
+template <typename T>
+struct IntegerConversion<T, T>
+{
+  static const T& cast(const T& x) { return x; }
+};
+
+template <>
+struct IntegerConversion<Int128, Integer256>
+{
+  static Int128 cast(const Integer256& x) { return x.toInt128(); }
+};
+
+template <>
+struct IntegerConversion<long long, Integer256>
+{
+  static long long cast(const Integer256& x) { return x.toInt64(); }
+};
+
+template <>
+struct IntegerConversion<DGtal::BigInteger, long long>
+{
+  static DGtal::BigInteger cast(const long long& x) 
+  { return IntegerTraits<DGtal::BigInteger>::castFromInt64(x); }
+};
+
+template <>
+struct IntegerConversion<DGtal::BigInteger, Int128>
+{
+  static DGtal::BigInteger cast(const Int128& x) 
+  { return IntegerTraits<DGtal::BigInteger>::castFromInt128(x); }
+};
+
+template <>
+struct IntegerConversion<long long, DGtal::BigInteger>
+{
+  static long long cast(const DGtal::BigInteger& x) 
+  { return IntegerTraits<DGtal::BigInteger>::castToInt64(x); }
+};
+
+template <>
+struct IntegerConversion<Int128, DGtal::BigInteger>
+{
+  static Int128 cast(const DGtal::BigInteger& x) 
+  { return IntegerTraits<DGtal::BigInteger>::castToInt128(x); }
+};
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Integer types used by ExactRayIntersectableCircle
+ * when all the computations are performed with the
+ * same integer type, whose overflows are either checked
+ * at run time or impossible (eg. DGtal::BigInteger).
+ *
+ * @tparam TInteger any integer type
+ */
+template <typename TInteger>
+struct UniformCircleTraits
+{
+  typedef TInteger Parameter;
+  typedef TInteger Value;
+  typedef TInteger Discriminant;
+};
+
+/**
+ * Integer types used by ExactRayIntersectableCircle,
+ * derived at compile time from a bound on the radius and
+ * a bound on the c-parameter, so that each expression
+ * is evaluated with the narrowest integer type that
+ * cannot overflow.
+ *
+ * The parameters are assumed to be normalized
+ * (see ExactRayIntersectableCircle::normalize), so that
+ * |a|, |b| <= |c| and |d| <= |c| (R^2 + 1/2).
+ * The evaluated points are assumed to lie at a distance
+ * from the origin of the local frame less than 2^(@a RadiusBits + 2),
+ * and the ray directions to have coordinates less
+ * than 2^(@a RadiusBits + 2), which holds for the points
+ * and directions (convergents) visited by the convex hull
+ * and alpha-shape algorithms.
+ * Then, the values of the function are less than 2^ValueBits
+ * and the discriminants computed in the ray casting, as well as
+ * the ones computed to get the lowest row, are less than
+ * 2^DiscriminantBits.
+ *
+ * Basic usage:
+ * @code
+ typedef CircleTraits<40, 20> Traits;
+ typedef ExactRayIntersectableCircle<Point, Traits::Parameter, Traits> Circle;
+ * @endcode
+ *
+ * @tparam RadiusBits number of bits of the radius R
+ * @tparam ParameterBits number of bits of the c-parameter
+ */
+template <int RadiusBits, int ParameterBits>
+struct CircleTraits
+{
+  enum {
+    CoordinateBits = RadiusBits + 2,
+    /* |d| < 2^(ParameterBits + 2 RadiusBits + 1) */
+    ParameterMaxBits = ParameterBits + 2*RadiusBits + 1,
+    /* c(x^2 + y^2) < 2^(ParameterBits + 2 CoordinateBits + 1),
+       including the linear coefficient and the square root
+       of the discriminant computed in the ray casting */
+    ValueBits = ParameterBits + 2*CoordinateBits + 4,
+    /* bEq^2 + 4 |aEq cEq| */
+    DiscriminantBits = 2*ValueBits + 2
+  };
+
+  typedef typename BoundedInteger<ParameterMaxBits>::Type Parameter;
+  typedef typename BoundedInteger<ValueBits>::Type Value;
+  typedef typename BoundedInteger<DiscriminantBits>::Type Discriminant;
+};
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Tag telling that CircumcircleRadiusPredicate evaluates
+ * its expressions with machine integers first and checks
+ * the overflows at run time (default).
+ */
+struct CheckedCircumcircleRadiusTraits
+{
+  static const bool isBounded = false;
+  typedef long long Area;
+  typedef long long Product;
+};
+
+/**
+ * Integer types used by CircumcircleRadiusPredicate,
+ * derived at compile time from a bound on the coordinates
+ * of the differences between the three points and a bound
+ * on the numerator and denominator of the squared radius,
+ * so that the expressions are evaluated with the narrowest
+ * integer type that cannot overflow, without any run time check.
+ * A radius whose numerator or denominator does not fit in
+ * @a FractionBits bits is rejected by the predicate constructor.
+ * The instantiation fails at compile time if the products
+ * do not fit in 255 bits or the fraction in 128-bit integers.
+ *
+ * @tparam CoordinateBits number of bits of the coordinates
+ * of the differences between the points
+ * @tparam FractionBits number of bits of the numerator
+ * and denominator of the squared radius
+ */
+template <int CoordinateBits, int FractionBits>
+struct CircumcircleRadiusTraits
+{
+  static_assert( (CoordinateBits >= 0) && (FractionBits >= 0), 
+		 "CircumcircleRadiusTraits: negative number of bits" );
+  static_assert( FractionBits <= 126, 
+		 "CircumcircleRadiusTraits: the radius fraction must fit in 128-bit integers" );
+
+  static const bool isBounded = true;
+
+  enum {
+    /* coordinates of the differences between the points */
+    MaxCoordinateBits = CoordinateBits,
+    /* numerator and denominator of the squared radius */
+    MaxFractionBits = FractionBits,
+    /* parallelogram area */
+    AreaBits = 2*CoordinateBits + 1,
+    /* leftPart = 4 area^2 num2 and
+       rightPart = |ab|^2 |bc|^2 |ac|^2 den2 */
+    ProductBits = 3*(2*CoordinateBits + 1) + FractionBits
+  };
+
+  typedef typename BoundedInteger<AreaBits>::Type Area;
+  typedef typename BoundedInteger<ProductBits>::Type Product;
+};
+
+#endif
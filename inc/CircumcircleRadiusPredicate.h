@@ -1,5 +1,12 @@
 #ifndef CircumcircleRadiusPredicate_h
 #define CircumcircleRadiusPredicate_h
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "IntegerHelpers.h"
+#include "CircleTraits.h"
+
 /**
  * @brief Class implementing a point predicate,
  * which compares a stored radius with the radius 
@@ -9,15 +16,34 @@
  *
  * This class is a model of ternary predicate.
  *
+ * The predicate is evaluated with machine integers first 
+ * and then with 128-bit integers, the computations being 
+ * checked against overflows. Type @a TInteger is used 
+ * only if both evaluations overflow, and DGtal::BigInteger 
+ * if @a TInteger overflows too, so that the result 
+ * does not depend on the precision actually used. 
+ *
+ * If the bounds of the input are known at compile time 
+ * (see CircumcircleRadiusTraits), the predicate is 
+ * evaluated once with the integer types given by 
+ * @a TTraits, without any overflow check, the choice 
+ * being made at compile time. The constructor then throws 
+ * std::out_of_range if the radius does not satisfy the bounds. 
+ *
  * @tparam TInteger any integer type for the 
  * numerator and denominator of the squared radius
+ * @tparam TTraits integer types of the area and products
+ * (by default, checked evaluation)
  */
-template<typename TInteger = long long int>
+template<typename TInteger = long long int, 
+	 typename TTraits = CheckedCircumcircleRadiusTraits>
 struct CircumcircleRadiusPredicate
 {
 public: 
   /* type of parameters */
   typedef TInteger Integer;
+  typedef typename TTraits::Area Area; 
+  typedef typename TTraits::Product Product; 
  
 private: 
   /////////////////////// members /////////////////////
@@ -29,6 +55,24 @@ private:
   Integer myDen2;
   bool positive; 
 
+  /**
+   * Copies of myNum2 and myDen2 in narrower integer types, 
+   * with flags telling whether the copies are valid
+   */
+  bool myIsInt64; 
+  long long myNum2Int64; 
+  long long myDen2Int64; 
+  bool myIsInt128; 
+  Int128 myNum2Int128; 
+  Int128 myDen2Int128; 
+
+  /**
+   * Copies of myNum2 and myDen2 in the product type
+   * (used only if the bounds are known at compile time)
+   */
+  Product myNum2Product; 
+  Product myDen2Product; 
+
 
 public:
   ///////////////////// standard services /////////////
@@ -39,19 +83,62 @@ public:
    * @param aPositive sign of alpha (default true)
    *
    * NB: Default values stands for an infinite radius. 
+   * @throw std::out_of_range if the bounds of @a TTraits
+   * are known at compile time and the radius does not satisfy them
    */
   CircumcircleRadiusPredicate(const Integer& aNum2 = 1, const Integer& aDen2 = 0, const bool& aPositive = true)
-    : myNum2(aNum2), myDen2(aDen2), positive(aPositive){}
+    : myNum2(aNum2), myDen2(aDen2), positive(aPositive)
+  {
+    typedef IntegerTraits<Integer> Traits; 
+    myIsInt64 = ( Traits::isInt64(myNum2) && Traits::isInt64(myDen2) ); 
+    myNum2Int64 = (myIsInt64)?Traits::castToInt64(myNum2):0; 
+    myDen2Int64 = (myIsInt64)?Traits::castToInt64(myDen2):0; 
+    myIsInt128 = ( Traits::isInt128(myNum2) && Traits::isInt128(myDen2) ); 
+    myNum2Int128 = (myIsInt128)?Traits::castToInt128(myNum2):0; 
+    myDen2Int128 = (myIsInt128)?Traits::castToInt128(myDen2):0; 
+    initProduct( std::integral_constant<bool, TTraits::isBounded>() ); 
+  }
 
   /**
    * Copy constructor
    * @param other other object to copy
    */
   CircumcircleRadiusPredicate(const CircumcircleRadiusPredicate& other)
-    : myNum2(other.myNum2), myDen2(other.myDen2), positive(other.positive) {}
+    : myNum2(other.myNum2), myDen2(other.myDen2), positive(other.positive), 
+      myIsInt64(other.myIsInt64), myNum2Int64(other.myNum2Int64), myDen2Int64(other.myDen2Int64), 
+      myIsInt128(other.myIsInt128), myNum2Int128(other.myNum2Int128), myDen2Int128(other.myDen2Int128), 
+      myNum2Product(other.myNum2Product), myDen2Product(other.myDen2Product) {}
 
 private:
 
+  /**
+   * Checks the radius against the bounds of the traits
+   * and copies it in the product type
+   * @throw std::out_of_range if the numerator or the 
+   * denominator is negative or does not fit in 
+   * TTraits::MaxFractionBits bits
+   */
+  void initProduct(std::true_type)
+  {
+    typedef IntegerTraits<Integer> Traits; 
+    if ( (myNum2 < 0) || (myDen2 < 0)
+	 || (Traits::bitLength(myNum2) > TTraits::MaxFractionBits)
+	 || (Traits::bitLength(myDen2) > TTraits::MaxFractionBits) )
+      throw std::out_of_range("CircumcircleRadiusPredicate: radius out of the bounds of the traits"); 
+    //the fraction fits in 128-bit integers and in the product type
+    myNum2Product = IntegerConversion<Product, Int128>::cast(myNum2Int128); 
+    myDen2Product = IntegerConversion<Product, Int128>::cast(myDen2Int128); 
+  }
+
+  /**
+   * No copy in the product type if the bounds are not known
+   */
+  void initProduct(std::false_type)
+  {
+    myNum2Product = 0; 
+    myDen2Product = 0; 
+  }
+
   /**
    * Assignement operator
    * @param other other object to copy
@@ -100,9 +187,15 @@ public:
   Integer 
   getArea(const Point& a, const Point& b, const Point& c) const
   {
-    Integer a0 = a[0]; Integer a1 = a[1];
-    Integer b0 = b[0]; Integer b1 = b[1];
-    Integer c0 = c[0]; Integer c1 = c[1];
+    typedef IntegerTraits<Integer> Traits; 
+    typedef IntegerTraits<typename Point::Coordinate> CoordinateTraits; 
+
+    Integer a0 = Traits::castFromInt64( CoordinateTraits::castToInt64(a[0]) ); 
+    Integer a1 = Traits::castFromInt64( CoordinateTraits::castToInt64(a[1]) ); 
+    Integer b0 = Traits::castFromInt64( CoordinateTraits::castToInt64(b[0]) ); 
+    Integer b1 = Traits::castFromInt64( CoordinateTraits::castToInt64(b[1]) ); 
+    Integer c0 = Traits::castFromInt64( CoordinateTraits::castToInt64(c[0]) ); 
+    Integer c1 = Traits::castFromInt64( CoordinateTraits::castToInt64(c[1]) ); 
     
     return a0*(b1 - c1) - b0*(a1 - c1) + c0*(a1 - b1);
   }
@@ -122,38 +215,177 @@ public:
   bool
   operator()(const Point& a, const Point& b, const Point& c) const
   {
-    
-    
-    Integer area = getArea(a,b,c);
-    
+    //bounds known at compile time or not
+    return evaluate(a, b, c, std::integral_constant<bool, TTraits::isBounded>()); 
+  }
+
+private: 
+
+  /**
+   * Given three points, computes the predicate value
+   * with machine integers, then 128-bit integers, then
+   * integers of type Integer, until there is no overflow. 
+   *
+   * @param a first point
+   * @param b second point
+   * @param c third point
+   * @return predicate value
+   *
+   * @tparam Point a model of point.   
+   */
+  template<typename Point>
+  bool
+  evaluate(const Point& a, const Point& b, const Point& c, std::false_type) const
+  {
+    bool res = false; 
+    //machine integers
+    if ( (myIsInt64) && (evaluate(a, b, c, myNum2Int64, myDen2Int64, res)) )
+      return res; 
+    //128-bit integers
+    if ( (myIsInt128) && (evaluate(a, b, c, myNum2Int128, myDen2Int128, res)) )
+      return res; 
+    //integers of type Integer
+    if (evaluate(a, b, c, myNum2, myDen2, res))
+      return res; 
+    //arbitrary precision integers, which never overflow
+    typedef IntegerConversion<DGtal::BigInteger, Integer> Conversion; 
+    evaluate(a, b, c, Conversion::cast(myNum2), Conversion::cast(myDen2), res); 
+    return res; 
+  }
+
+  /**
+   * Given three points, computes the predicate value
+   * with the integer types Area and Product, which 
+   * cannot overflow since the differences between the points
+   * satisfy the bounds given by the traits (see difference). 
+   *
+   * @param a first point
+   * @param b second point
+   * @param c third point
+   * @return predicate value
+   *
+   * @tparam Point a model of point.   
+   */
+  template<typename Point>
+  bool
+  evaluate(const Point& a, const Point& b, const Point& c, std::true_type) const
+  {
+    typedef IntegerConversion<Product, Area> Widening; 
+
+    Area ab0 = difference(b[0], a[0]); 
+    Area ab1 = difference(b[1], a[1]); 
+    Area bc0 = difference(c[0], b[0]); 
+    Area bc1 = difference(c[1], b[1]); 
+    Area ac0 = difference(c[0], a[0]); 
+    Area ac1 = difference(c[1], a[1]); 
+
+    Area area = ab0*ac1 - ab1*ac0; 
+    if (area == 0)
+      return (myDen2Product == 0 || positive); 
+    if (( positive && area > 0) || (!positive && area < 0) )
+      return positive; 
+
+    Product lab = Widening::cast(ab0*ab0 + ab1*ab1); 
+    Product lbc = Widening::cast(bc0*bc0 + bc1*bc1); 
+    Product lac = Widening::cast(ac0*ac0 + ac1*ac1); 
+    Product rightPart = lab*lbc*lac*myDen2Product; 
+    Product leftPart = 4*Widening::cast(area)*Widening::cast(area)*myNum2Product; 
+    return (positive == (leftPart < rightPart)); 
+  }
+
+  /**
+   * Difference between two coordinates, which must fit in 
+   * TTraits::MaxCoordinateBits bits, like the radius fraction 
+   * in TTraits::MaxFractionBits bits (see initProduct)
+   * @param x any coordinate
+   * @param y any coordinate
+   * @return @a x - @a y
+   *
+   * @tparam Coordinate a model of integer. 
+   */
+  template<typename Coordinate>
+  Area
+  difference(const Coordinate& x, const Coordinate& y) const
+  {
+    typedef IntegerTraits<Coordinate> CoordinateTraits; 
+    long long d = CoordinateTraits::castToInt64(x) - CoordinateTraits::castToInt64(y); 
+    ASSERT( (IntegerTraits<long long>::bitLength(d) <= TTraits::MaxCoordinateBits)
+	    && "Error in CircumcircleRadiusPredicate: difference out of the bounds of the traits" ); 
+    return IntegerTraits<Area>::castFromInt64(d); 
+  }
+
+  /**
+   * Given three points, computes the predicate value
+   * with integers of type T. 
+   *
+   * @param a first point
+   * @param b second point
+   * @param c third point
+   * @param aNum2 squared numerator of the radius
+   * @param aDen2 squared denominator of the radius
+   * @param aRes (returned) predicate value
+   * @return 'false' if an overflow occured (and @a aRes 
+   * is not set), 'true' otherwise
+   *
+   * @tparam Point a model of point.   
+   * @tparam T a model of integer.   
+   */
+  template<typename Point, typename T>
+  bool
+  evaluate(const Point& a, const Point& b, const Point& c, 
+	   const T& aNum2, const T& aDen2, bool& aRes) const
+  {
+    typedef IntegerTraits<T> Traits; 
+    typedef IntegerTraits<typename Point::Coordinate> CoordinateTraits; 
+
+    T a0 = Traits::castFromInt64( CoordinateTraits::castToInt64(a[0]) ); 
+    T a1 = Traits::castFromInt64( CoordinateTraits::castToInt64(a[1]) ); 
+    T b0 = Traits::castFromInt64( CoordinateTraits::castToInt64(b[0]) ); 
+    T b1 = Traits::castFromInt64( CoordinateTraits::castToInt64(b[1]) ); 
+    T c0 = Traits::castFromInt64( CoordinateTraits::castToInt64(c[0]) ); 
+    T c1 = Traits::castFromInt64( CoordinateTraits::castToInt64(c[1]) ); 
+
+    T ab0, ab1, bc0, bc1, ac0, ac1; 
+    if ( !( Traits::sub(b0, a0, ab0) && Traits::sub(b1, a1, ab1) 
+	    && Traits::sub(c0, b0, bc0) && Traits::sub(c1, b1, bc1)
+	    && Traits::sub(c0, a0, ac0) && Traits::sub(c1, a1, ac1) ) )
+      return false; 
+
+    //area, equal to the one returned by getArea
+    T p, q, area; 
+    if ( !( Traits::mul(ab0, ac1, p) && Traits::mul(ab1, ac0, q) 
+	    && Traits::sub(p, q, area) ) )
+      return false; 
+
     if (area == 0)
     {
-      return( (myDen2 == 0 || positive)?true:false);
+      aRes = ( (aDen2 == 0 || positive)?true:false ); 
+      return true; 
     }
     
     if (( positive && area > 0) || (!positive && area < 0) )
     {
-      return ( (true && positive) );
+      aRes = ( (true && positive) ); 
+      return true; 
     }
-    
-    Point ab = (b-a); 
-    Point bc = (c-b); 
-    Point ac = (c-a);
-    
-    //myX * myX + myY * myY
-   
-    Integer ab0 = ab[0]; 	Integer ab1 = ab[1];
-    Integer bc0 = bc[0]; 	Integer bc1 = bc[1];
-    Integer ac0 = ac[0]; 	Integer ac1 = ac[1];
-    
-    Integer rightPart = (ab0*ab0 + ab1*ab1)*(bc0*bc0 + bc1*bc1)*
-      (ac0*ac0 + ac1*ac1)*myDen2; 
 
-    Integer leftPart = 4*area*area*myNum2;
+    //squared lengths 
+    T lab, lbc, lac; 
+    if ( !( Traits::mul(ab0, ab0, p) && Traits::mul(ab1, ab1, q) && Traits::add(p, q, lab)
+	    && Traits::mul(bc0, bc0, p) && Traits::mul(bc1, bc1, q) && Traits::add(p, q, lbc)
+	    && Traits::mul(ac0, ac0, p) && Traits::mul(ac1, ac1, q) && Traits::add(p, q, lac) ) )
+      return false; 
 
-    return (positive == (leftPart < rightPart));
-    //return ( positive?(leftPart <= rightPart):(leftPart >= rightPart) );
+    T rightPart, leftPart; 
+    if ( !( Traits::mul(lab, lbc, p) && Traits::mul(p, lac, q) 
+	    && Traits::mul(q, aDen2, rightPart) ) )
+      return false; 
+    if ( !( Traits::mul(area, area, p) && Traits::mul(p, aNum2, q) 
+	    && Traits::mul(q, Traits::castFromInt64(4), leftPart) ) )
+      return false; 
 
+    aRes = (positive == (leftPart < rightPart)); 
+    return true; 
   }
 }; 
 
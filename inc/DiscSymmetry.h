@@ -0,0 +1,570 @@
+#ifndef DiscSymmetry_h
+#define DiscSymmetry_h
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+#include "IntegerHelpers.h"
+
+template <typename TPoint, typename TParameter, typename TTraits>
+class ExactRayIntersectableCircle;
+template <typename TPoint>
+class AdaptiveRayIntersectableCircle;
+template <typename TShape>
+class FilteredRayIntersectableCircle;
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Copies a cyclic sequence of vertices from a given vertex
+ * @param aVertices vertices in a counter-clockwise order
+ * @param aStartingPoint first vertex to copy, which must belong to @a aVertices
+ * @param res output iterator that stores the sequence of vertices
+ */
+template <typename Point, typename OutputIterator>
+void rotatedCopy(const std::vector<Point>& aVertices, const Point& aStartingPoint,
+		 OutputIterator res)
+{
+  typename std::vector<Point>::const_iterator it
+    = std::find(aVertices.begin(), aVertices.end(), aStartingPoint);
+  ASSERT( (it != aVertices.end()) && "Error in rotatedCopy: starting point not found" );
+  std::copy(it, aVertices.end(), res);
+  std::copy(aVertices.begin(), it, res);
+}
+
+/////////////////////////////////////////////////////////////////////
+/**
+ * Class describing the symmetries of the set of digital
+ * points lying inside a shape, ie. the isometries mapping
+ * the digital plane onto itself and the shape onto itself.
+ * By default, the shape has no symmetry.
+ *
+ * @tparam TShape a model of ray intersectable shape
+ */
+template <typename TShape>
+class DiscSymmetry
+{
+public:
+  typedef typename TShape::Point Point;
+
+  /**
+   * Constructor
+   * @param aShape any shape
+   * @param aStartingPoint any vertex
+   */
+  DiscSymmetry(const TShape& aShape, const Point& aStartingPoint)
+    : myFirstVertex(aStartingPoint) {}
+
+  /**
+   * @return order of the symmetry group,
+   * ie. 1 since there is no symmetry
+   */
+  int getOrder() const { return 1; }
+
+  /**
+   * @return first ray of the fundamental domain,
+   * ie. 0 since it is the whole plane
+   */
+  int getFirstRay() const { return 0; }
+
+  /**
+   * @return vertex from which the vertices are retrieved
+   */
+  const Point& getFirstVertex() const { return myFirstVertex; }
+
+  /**
+   * @param aPoint any point
+   * @return 'true' since the whole plane is a fundamental domain
+   */
+  bool isInSector(const Point& aPoint) const { return true; }
+
+  /**
+   * Copies the vertices
+   * @param aArc vertices in a counter-clockwise order
+   * @param aStartingPoint first vertex
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void unfold(const std::vector<Point>& aArc, const Point& aStartingPoint,
+	      OutputIterator res) const
+  {
+    rotatedCopy(aArc, aStartingPoint, res);
+  }
+
+  /**
+   * Copies all the vertices
+   * @param aVertices vertices in a counter-clockwise order
+   * @param aStartingPoint first vertex
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void rotate(const std::vector<Point>& aVertices, const Point& aStartingPoint,
+	      OutputIterator res) const
+  {
+    rotatedCopy(aVertices, aStartingPoint, res);
+  }
+
+private:
+  /**
+   * Vertex from which the vertices are retrieved
+   */
+  Point myFirstVertex;
+};
+
+/**
+ * Class describing the symmetries of the set of digital
+ * points lying inside a circle, which are detected from the
+ * circle parameters: the circle center (-a/2c, -b/2c) has
+ * integer or half-integer coordinates if c divides a and b,
+ * and lies on a diagonal of the digital plane
+ * if 2c divides a - b or a + b.
+ * The symmetry group is either
+ * - the dihedral group of the square (order 8),
+ * - the group generated by the reflections across the
+ * horizontal and vertical lines passing through the center (order 4),
+ * - the group generated by one reflection (order 2),
+ * - the trivial group (order 1).
+ *
+ * The plane is divided into as many angular sectors around
+ * the center, bounded by the lines of the reflections. 
+ * The vertices of the first one (the fundamental sector) are 
+ * retrieved by walking counter-clockwise from a vertex lying
+ * just before its first ray (see getFirstVertex), which is 
+ * derived from the vertices that are extremal in the axis
+ * directions, and the other ones are obtained by symmetry 
+ * (see unfold).
+ *
+ * All computations are exact: the group is detected with the
+ * parameters, but each isometry x -> M x + t and each line of
+ * a reflection is then given by integer coordinates, so that
+ * the vertices are cheaply tested and transformed.
+ *
+ * @tparam TShape a model of circle, providing the parameters
+ * a, b, c and the origin of their local frame.
+ */
+template <typename TShape>
+class CircleDiscSymmetry
+{
+public:
+  typedef typename TShape::Point Point;
+  typedef typename Point::Coordinate Coordinate;
+  typedef typename TShape::Integer Integer;
+
+private:
+  /**
+   * Circle parameters and origin of their local frame
+   */
+  Integer myA, myB, my2C;
+  Point myShift;
+
+  /**
+   * Order of the symmetry group
+   */
+  int myOrder;
+
+  /**
+   * First ray of the fundamental sector, whose angle
+   * is @a myFirstRay * pi/4
+   */
+  int myFirstRay;
+
+  /**
+   * Twice the determinants of the first and last rays
+   * of the fundamental sector and of the center
+   * (see isInSector)
+   */
+  Coordinate myFirstOffset, myLastOffset;
+
+  /**
+   * Vertex from which the walk starts, which does not lie
+   * inside the fundamental sector, except on its first ray
+   */
+  Point myFirstVertex;
+
+public:
+  /**
+   * Constructor
+   * @param aShape any circle
+   * @param aStartingPoint any vertex of the convex hull
+   * (or alpha-shape) of the digital points lying inside it
+   */
+  CircleDiscSymmetry(const TShape& aShape, const Point& aStartingPoint)
+    : myA(aShape.a()), myB(aShape.b()), my2C(2*aShape.c()),
+      myShift(aShape.getShift()), myOrder(1), myFirstRay(0),
+      myFirstOffset(0), myLastOffset(0), myFirstVertex(aStartingPoint)
+  {
+    const Integer zero(0);
+    if ( !(my2C < zero) )
+      return;
+    Integer c = aShape.c();
+    bool isX = ( (myA % c) == zero );          //vertical line
+    bool isY = ( (myB % c) == zero );          //horizontal line
+    bool isD = ( ((myB - myA) % my2C) == zero ); //diagonal
+    bool isA = ( ((myA + myB) % my2C) == zero ); //anti-diagonal
+    //possible first rays (the lines of the reflections)
+    std::vector<int> rays;
+    if (isX && isY && isD && isA)
+      {
+	myOrder = 8;
+	for (int m = 0; m < 8; m++)
+	  rays.push_back(m);
+      }
+    else if (isX && isY)
+      {
+	myOrder = 4;
+	for (int m = 0; m < 8; m += 2)
+	  rays.push_back(m);
+      }
+    else if (isX || isY || isD || isA)
+      {
+	myOrder = 2;
+	int m = (isY)?0:( (isD)?1:( (isX)?2:3 ) );
+	rays.push_back(m);
+	rays.push_back(m+4);
+      }
+    if (myOrder == 1)
+      return;
+
+    //the walk starts from a vertex lying just before a ray 
+    //(or on it), which is the first one of the vertices that
+    //are extremal in the direction of the ray if it is an axis
+    //(the mirror image of the last one), or the last one of the 
+    //vertices that are extremal in the direction of the previous 
+    //axis otherwise
+    std::vector<Point> extremes;
+    aShape.getExtremalVertices( std::back_inserter(extremes) );
+    for (int parity = 0; parity < 2; parity++)
+      for (unsigned int i = 0; i < rays.size(); i++)
+	{
+	  int m = rays[i];
+	  if (m%2 != parity)
+	    continue;
+	  Point p = extremes[ (((m - parity)/2) + 1) % 4 ];
+	  if (parity == 0)
+	    { //reflection across the line of the ray
+	      int cosinus, sinus;
+	      quarterTurn( m, cosinus, sinus );
+	      Point t = translation(cosinus, sinus, sinus, -cosinus);
+	      p = Point( cosinus*p[0] + sinus*p[1] + t[0], sinus*p[0] - cosinus*p[1] + t[1] );
+	    }
+	  if (setSector(m, p))
+	    return;
+	}
+    //otherwise, the walk starts from the given vertex
+    for (unsigned int i = 0; i < rays.size(); i++)
+      if (setSector(rays[i], aStartingPoint))
+	return;
+    //the starting point is the center
+    myOrder = 1;
+    myFirstRay = 0;
+  }
+
+  /**
+   * @return order of the symmetry group
+   */
+  int getOrder() const { return myOrder; }
+
+  /**
+   * @return first ray of the fundamental sector,
+   * whose angle is the returned value times pi/4
+   */
+  int getFirstRay() const { return myFirstRay; }
+
+  /**
+   * @return vertex from which the vertices of the 
+   * fundamental sector are retrieved
+   */
+  const Point& getFirstVertex() const { return myFirstVertex; }
+
+  /**
+   * @param aPoint any point
+   * @return 'true' if @a aPoint lies in the (closed)
+   * fundamental sector, 'false' otherwise
+   */
+  bool isInSector(const Point& aPoint) const
+  {
+    if (myOrder == 1)
+      return true;
+    //det(d, p - center) has the sign of 2 det(d, p) - 2 det(d, center)
+    int dx, dy;
+    ray(myFirstRay, dx, dy);
+    Coordinate first = 2*(dx*aPoint[1] - dy*aPoint[0]) - myFirstOffset;
+    ray(myFirstRay + 8/myOrder, dx, dy);
+    Coordinate last = 2*(dx*aPoint[1] - dy*aPoint[0]) - myLastOffset;
+    return ( (first >= 0) && (last <= 0) );
+  }
+
+  /**
+   * Retrieves all the vertices from the ones lying in the
+   * fundamental sector: the k-th sector is the image of the
+   * fundamental sector by the rotation of angle k * 2pi/n if k
+   * is even and by the reflection across the line of angle
+   * (k+1) * pi/n if k is odd (n being the order),
+   * which reverses the order of the vertices.
+   * The vertices lying on the rays, which belong to two sectors,
+   * are only retrieved once.
+   * @param aArc vertices of the fundamental sector in a
+   * counter-clockwise order (other vertices are ignored)
+   * @param aStartingPoint first vertex
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void unfold(const std::vector<Point>& aArc, const Point& aStartingPoint,
+	      OutputIterator res) const
+  {
+    std::vector<Point> arc;
+    for (unsigned int i = 0; i < aArc.size(); i++)
+      if (isInSector(aArc[i]))
+	arc.push_back(aArc[i]);
+
+    std::vector<Point> vertices;
+    vertices.reserve(arc.size() * myOrder);
+    for (int k = 0; k < myOrder; k++)
+      {
+	//2x2 matrix of the isometry (in the centered frame)
+	int m00, m01, m10, m11;
+	if (k%2 == 0)
+	  { //rotation by k quarter turns of 8/n
+	    int cosinus, sinus;
+	    quarterTurn( k*4/myOrder, cosinus, sinus );
+	    m00 = cosinus; m01 = -sinus;
+	    m10 = sinus;   m11 = cosinus;
+	  }
+	else
+	  { //reflection across the line of angle phi,
+	    //ie. matrix of the rotation of angle 2 phi
+	    //composed with the reflection (x,y) -> (x,-y)
+	    int cosinus, sinus;
+	    quarterTurn( myFirstRay + 4*(k+1)/myOrder, cosinus, sinus );
+	    m00 = cosinus; m01 = sinus;
+	    m10 = sinus;   m11 = -cosinus;
+	  }
+	Point t = translation(m00, m01, m10, m11);
+	for (unsigned int i = 0; i < arc.size(); i++)
+	  {
+	    const Point& p = (k%2 == 0)?arc[i]:arc[arc.size()-1-i];
+	    Point q( m00*p[0] + m01*p[1] + t[0], m10*p[0] + m11*p[1] + t[1] );
+	    if ( (vertices.empty()) || (vertices.back() != q) )
+	      vertices.push_back(q);
+	  }
+      }
+    while ( (vertices.size() > 1) && (vertices.back() == vertices.front()) )
+      vertices.pop_back();
+
+    rotatedCopy(vertices, aStartingPoint, res);
+  }
+
+  /**
+   * Copies all the vertices
+   * @param aVertices vertices in a counter-clockwise order
+   * @param aStartingPoint first vertex
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void rotate(const std::vector<Point>& aVertices, const Point& aStartingPoint,
+	      OutputIterator res) const
+  {
+    rotatedCopy(aVertices, aStartingPoint, res);
+  }
+
+private:
+  /**
+   * Chooses the fundamental sector and the first vertex
+   * @param aM first ray of the sector (angle @a aM * pi/4)
+   * @param aPoint any vertex
+   * @return 'true' if @a aPoint does not lie inside the sector, 
+   * except on its first ray (then, the choice is done),
+   * 'false' otherwise
+   */
+  bool setSector(int aM, const Point& aPoint)
+  {
+    const Integer zero(0);
+    Integer x, y;
+    toCenteredFrame(aPoint, x, y);
+    myFirstRay = aM;
+    if ( (!isInSector(x, y))
+	 || ( (cross(myFirstRay, x, y) == zero) && (dot(myFirstRay, x, y) > zero) ) )
+      {
+	myFirstOffset = offset(myFirstRay);
+	myLastOffset = offset(myFirstRay + 8/myOrder);
+	myFirstVertex = aPoint;
+	return true;
+      }
+    return false;
+  }
+
+  /**
+   * Computes the coordinates of a point w.r.t. the center
+   * multiplied by -2c, ie. -(2c x + a) and -(2c y + b)
+   * in the local frame
+   * @param aPoint any point
+   * @param aX (returned) x-coordinate
+   * @param aY (returned) y-coordinate
+   */
+  void toCenteredFrame(const Point& aPoint, Integer& aX, Integer& aY) const
+  {
+    typedef IntegerTraits<Integer> Traits;
+    aX = -( my2C*Traits::castFromInt64(aPoint[0] - myShift[0]) + myA );
+    aY = -( my2C*Traits::castFromInt64(aPoint[1] - myShift[1]) + myB );
+  }
+
+  /**
+   * @param aM any integer
+   * @param aCos (returned) cosinus of @a aM * pi/2
+   * @param aSin (returned) sinus of @a aM * pi/2
+   */
+  static void quarterTurn(int aM, int& aCos, int& aSin)
+  {
+    static const int cosinus[4] = {1, 0, -1, 0};
+    static const int sinus[4] = {0, 1, 0, -1};
+    int m = ((aM % 4) + 4) % 4;
+    aCos = cosinus[m];
+    aSin = sinus[m];
+  }
+
+  /**
+   * @param aS any integer among -2, -1, 0, 1, 2
+   * @param aX any integer
+   * @param aT any integer among -2, -1, 0, 1, 2
+   * @param aY any integer
+   * @return @a aS * @a aX + @a aT * @a aY
+   */
+  static Integer combine(int aS, const Integer& aX, int aT, const Integer& aY)
+  {
+    Integer res(0);
+    for (int i = 0; i < aS; i++) res += aX;
+    for (int i = 0; i > aS; i--) res -= aX;
+    for (int i = 0; i < aT; i++) res += aY;
+    for (int i = 0; i > aT; i--) res -= aY;
+    return res;
+  }
+
+  /**
+   * @param aM any integer
+   * @param aDx (returned) x-coordinate of a vector of angle @a aM * pi/4
+   * @param aDy (returned) y-coordinate of a vector of angle @a aM * pi/4
+   */
+  static void ray(int aM, int& aDx, int& aDy)
+  {
+    static const int dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static const int dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    int m = ((aM % 8) + 8) % 8;
+    aDx = dx[m];
+    aDy = dy[m];
+  }
+
+  /**
+   * @param aM any integer
+   * @param aX x-coordinate of any vector
+   * @param aY y-coordinate of any vector
+   * @return determinant of the vector of angle @a aM * pi/4
+   * and the vector (@a aX, @a aY)
+   */
+  static Integer cross(int aM, const Integer& aX, const Integer& aY)
+  {
+    int dx, dy;
+    ray(aM, dx, dy);
+    return combine(-dy, aX, dx, aY);
+  }
+
+  /**
+   * @param aM any integer
+   * @param aX x-coordinate of any vector
+   * @param aY y-coordinate of any vector
+   * @return dot product of the vector of angle @a aM * pi/4
+   * and the vector (@a aX, @a aY)
+   */
+  static Integer dot(int aM, const Integer& aX, const Integer& aY)
+  {
+    int dx, dy;
+    ray(aM, dx, dy);
+    return combine(dx, aX, dy, aY);
+  }
+
+  /**
+   * @param aX x-coordinate in the centered frame
+   * @param aY y-coordinate in the centered frame
+   * @return 'true' if the point lies in the (closed)
+   * fundamental sector, 'false' otherwise
+   */
+  bool isInSector(const Integer& aX, const Integer& aY) const
+  {
+    const Integer zero(0);
+    if (myOrder == 1)
+      return true;
+    //the angle of the sector is 2pi/n, ie. 8/n times pi/4
+    int lastRay = myFirstRay + 8/myOrder;
+    return ( (cross(myFirstRay, aX, aY) >= zero)
+	     && (cross(lastRay, aX, aY) <= zero) );
+  }
+
+  /**
+   * Computes the translation t of an isometry x -> M (x - o) + o,
+   * where o is the center and M = [m00, m01; m10, m11],
+   * ie. t = o - M o. Its coordinates are integers
+   * because the isometry belongs to the symmetry group.
+   * @return translation of the isometry
+   */
+  Point translation(int m00, int m01, int m10, int m11) const
+  {
+    typedef IntegerTraits<Integer> Traits;
+    //the center is equal to (-a, -b) / 2c in the local frame
+    Integer tx = -( combine(1 - m00, myA, -m01, myB) ) / my2C;
+    Integer ty = -( combine(-m10, myA, 1 - m11, myB) ) / my2C;
+    Point t( (Coordinate) Traits::castToInt64(tx),
+	     (Coordinate) Traits::castToInt64(ty) );
+    //translation of the local frame
+    return t + myShift - Point( m00*myShift[0] + m01*myShift[1],
+				m10*myShift[0] + m11*myShift[1] );
+  }
+
+  /**
+   * Computes twice the determinant of the vector of angle @a aM * pi/4
+   * and the center, which is an integer if the line passing through
+   * the center along this vector is the line of a reflection.
+   * @param aM any integer
+   * @return twice the determinant
+   */
+  Coordinate offset(int aM) const
+  {
+    typedef IntegerTraits<Integer> Traits;
+    int dx, dy;
+    ray(aM, dx, dy);
+    //2 (dx y - dy x) with (x, y) = (-a, -b) / 2c in the local frame
+    Integer o = -( combine(-dy, myA, dx, myB) ) / (my2C / 2);
+    return (Coordinate) Traits::castToInt64(o)
+      + 2*(dx*myShift[1] - dy*myShift[0]);
+  }
+};
+
+template <typename TPoint, typename TParameter, typename TTraits>
+class DiscSymmetry<ExactRayIntersectableCircle<TPoint, TParameter, TTraits> >
+  : public CircleDiscSymmetry<ExactRayIntersectableCircle<TPoint, TParameter, TTraits> >
+{
+public:
+  typedef ExactRayIntersectableCircle<TPoint, TParameter, TTraits> Shape;
+  DiscSymmetry(const Shape& aShape, const TPoint& aStartingPoint)
+    : CircleDiscSymmetry<Shape>(aShape, aStartingPoint) {}
+};
+
+template <typename TPoint>
+class DiscSymmetry<AdaptiveRayIntersectableCircle<TPoint> >
+  : public CircleDiscSymmetry<AdaptiveRayIntersectableCircle<TPoint> >
+{
+public:
+  typedef AdaptiveRayIntersectableCircle<TPoint> Shape;
+  DiscSymmetry(const Shape& aShape, const TPoint& aStartingPoint)
+    : CircleDiscSymmetry<Shape>(aShape, aStartingPoint) {}
+};
+
+template <typename TShape>
+class DiscSymmetry<FilteredRayIntersectableCircle<TShape> >
+  : public CircleDiscSymmetry<FilteredRayIntersectableCircle<TShape> >
+{
+public:
+  typedef FilteredRayIntersectableCircle<TShape> Shape;
+  DiscSymmetry(const Shape& aShape, const typename Shape::Point& aStartingPoint)
+    : CircleDiscSymmetry<Shape>(aShape, aStartingPoint) {}
+};
+
+#endif
@@ -2,10 +2,15 @@
 #define ExactRayIntersectableCircle_h
 
 #include <cmath>
+#include <algorithm>
+#include <type_traits>
 
 #include <DGtal/kernel/NumberTraits.h>
 #include <DGtal/base/BasicFunctors.h>
 
+#include "IntegerHelpers.h"
+#include "CircleTraits.h"
+
  
 /**
  * Class implementing a circle that is 'ray intersectable', 
@@ -13,12 +18,20 @@
  * a ray emanating from a given point along a given direction
  * is computable.
  * 
+ * The values of the function and the discriminants 
+ * computed in the ray casting are represented by the integer
+ * types given by @a TTraits, which may be wider than the type
+ * of the parameters (see CircleTraits). 
+ * 
  * @tparam Point a model of point/vector.  
  * @tparam Parameter a model of integer for the circle parameters
+ * @tparam TTraits integer types of the values and discriminants
+ * (by default, the type of the parameters)
  *
  * This class is a model of point functor and of ray intersectable shape
  */
-template <typename TPoint, typename TParameter = long long int>
+template <typename TPoint, typename TParameter = long long int, 
+	  typename TTraits = UniformCircleTraits<TParameter> >
 class ExactRayIntersectableCircle 
 {
 public: 
@@ -27,7 +40,11 @@ public:
   typedef TPoint Vector; 
   typedef typename TPoint::Coordinate Coordinate; 
   typedef TParameter Integer; 
-  typedef Integer Value; 
+  typedef typename TTraits::Value Value; 
+  typedef typename TTraits::Discriminant Discriminant; 
+
+  static_assert( std::is_same<Integer, typename TTraits::Parameter>::value, 
+		 "ExactRayIntersectableCircle: parameter type does not match the traits" ); 
 
 private: 
   /////////////////////// members /////////////////////
@@ -36,15 +53,30 @@ private:
    * as the set {(x,y) | ax + by + c(x^2 + y^2) + d = 0}
    * The center is equal to ( -a/(2c) , -b/(2c) ) and the 
    * radius is equal to sqrt( (a^2 + b^2 - 4cd) / 4c^2 )
+   * NB: the parameters are given in a local frame, whose
+   * origin is @a myShift (see normalize). 
    */
   Integer myA, myB, myC, myD;  
 
+  /**
+   * Invariant cached once for all, 
+   * equal to 2c
+   */
+  Integer my2C; 
+
+  /**
+   * Origin of the local frame of the parameters, 
+   * ie. the circle is the set {p | f(p - myShift) = 0}, 
+   * where f is the function given by the parameters 
+   */
+  Point myShift; 
+
 public:
   ///////////////////// standard services /////////////
   /**
    * Default constructor
    */
-  ExactRayIntersectableCircle(): myA(0), myB(0), myC(0), myD(0) {}
+  ExactRayIntersectableCircle(): myA(0), myB(0), myC(0), myD(0), my2C(0), myShift(0,0) {}
 
   /**
    * Standard constructor
@@ -54,7 +86,19 @@ public:
    * @param d d-parameter
    */
   ExactRayIntersectableCircle(const Integer& a, const Integer& b, const Integer& c, const Integer& d)
-    : myA(a), myB(b), myC(c), myD(d) {}
+    : myA(a), myB(b), myC(c), myD(d), my2C(2*c), myShift(0,0) {}
+
+  /**
+   * Constructor from parameters given in a local frame
+   * @param a a-parameter
+   * @param b b-parameter
+   * @param c c-parameter
+   * @param d d-parameter
+   * @param aShift origin of the local frame
+   */
+  ExactRayIntersectableCircle(const Integer& a, const Integer& b, const Integer& c, const Integer& d, 
+			      const Point& aShift)
+    : myA(a), myB(b), myC(c), myD(d), my2C(2*c), myShift(aShift) {}
 
   /**
    * Constructor from three points
@@ -63,13 +107,14 @@ public:
    * @param aR third point
    */
   ExactRayIntersectableCircle(const Point& aP, const Point& aQ, const Point& aR)
+    : myShift(0,0)
   {
-    Integer px = aP[0]; 
-    Integer qx = aQ[0]; 
-    Integer rx = aR[0];
-    Integer py = aP[1]; 
-    Integer qy = aQ[1]; 
-    Integer ry = aR[1];
+    Integer px = toInteger(aP[0]); 
+    Integer qx = toInteger(aQ[0]); 
+    Integer rx = toInteger(aR[0]);
+    Integer py = toInteger(aP[1]); 
+    Integer qy = toInteger(aQ[1]); 
+    Integer ry = toInteger(aR[1]);
     Integer pz = px*px + py*py; 
     Integer qz = qx*qx + qy*qy; 
     Integer rz = rx*rx + ry*ry; 
@@ -78,13 +123,15 @@ public:
     myB = px*(qz - rz) - qx*(pz - rz) + rx*(pz - qz);
     myC = - px*(qy - ry) + qx*(py - ry) - rx*(py - qy); 
     myD = px*(qy*rz - ry*qz) - qx*(py*rz - ry*pz) + rx*(py*qz - qy*pz); 
+    my2C = 2*myC; 
   }
 
   /**
    * Copy constructor
    * @param p other object to copy
    */
-  ExactRayIntersectableCircle(const ExactRayIntersectableCircle& p): myA(p.a()), myB(p.b()), myC(p.c()), myD(p.d()) {}
+  ExactRayIntersectableCircle(const ExactRayIntersectableCircle& p): myA(p.a()), myB(p.b()), myC(p.c()), myD(p.d()), 
+    my2C(p.my2C), myShift(p.getShift()) {}
 
   /**
    * Assignement operator
@@ -93,12 +140,14 @@ public:
    */
   ExactRayIntersectableCircle& operator=(const ExactRayIntersectableCircle& p) 
   {
-    if (p != *this)
+    if (&p != this)
       {
         myA = p.a(); 
         myB = p.b(); 
         myC = p.c(); 
         myD = p.d();
+        my2C = p.my2C; 
+        myShift = p.getShift(); 
       }
     return *this; 
   }
@@ -108,7 +157,55 @@ public:
    */
   ~ExactRayIntersectableCircle() {}
 
+  /**
+   * Normalizes the parameters, so that their size is minimal: 
+   * they are divided by their gcd (which preserves their sign, 
+   * and thus the sign convention of the function) and the origin
+   * of the local frame is moved to the digital point that is 
+   * the closest to the center. Then, a and b are bounded by |c|
+   * and d by |c| times the squared radius (plus a constant), 
+   * whatever the location of the circle. 
+   * The results are still given in the original frame. 
+   * NB: the type Integer must be able to represent the 
+   * intermediate values (of the order of the original parameters).
+   */
+  void normalize()
+  {
+    Integer g = greatestCommonDivisor( greatestCommonDivisor(myA, myB), 
+				       greatestCommonDivisor(myC, myD) ); 
+    if (g > 1)
+      {
+	myA /= g; 
+	myB /= g; 
+	myC /= g; 
+	myD /= g; 
+	my2C = 2*myC; 
+      }
+    if (myC != 0)
+      { 
+	//closest digital point to the center (-a/2c, -b/2c)
+	Integer den = (myC < 0)?Integer(-2*my2C):Integer(2*my2C); 
+	Integer nx = (myC < 0)?Integer(2*myA):Integer(-2*myA); 
+	Integer ny = (myC < 0)?Integer(2*myB):Integer(-2*myB); 
+	Integer tx = floorDivision(Integer(nx + den/2), den); 
+	Integer ty = floorDivision(Integer(ny + den/2), den); 
+	//parameters in the new local frame
+	myD = myA*tx + myB*ty + myC*(tx*tx + ty*ty) + myD; 
+	myA += my2C*tx; 
+	myB += my2C*ty; 
+	myShift += Point( IntegerTraits<Integer>::castToInt64(tx), 
+			  IntegerTraits<Integer>::castToInt64(ty) ); 
+      }
+  }
+
   ///////////////////// read access ///////////////////
+  /**
+   * Origin of the local frame accessor
+   * @return the point that the parameters are relative to
+   * ((0,0) unless the circle is normalized)
+   */
+  Point getShift() const { return myShift; }
+
   /**
    * a-parameter accessor
    * @return a-parameter. 
@@ -139,11 +236,23 @@ public:
    */
   double getRadius() const 
   { 
-    double den = DGtal::NumberTraits<Integer>::castToDouble(4*myC*myC);
-    double v1 = DGtal::NumberTraits<Integer>::castToDouble(myA*myA) / den;
-    double v2 = DGtal::NumberTraits<Integer>::castToDouble(myB*myB) / den; 
-    double v3 = DGtal::NumberTraits<Integer>::castToDouble(myD)
-      / DGtal::NumberTraits<Integer>::castToDouble(myC); 
+    typedef IntegerTraits<Integer> Traits; 
+    //exact numerator whenever possible, in order to 
+    //avoid cancellations for circles far from the origin
+    Integer aa, bb, cd, num; 
+    if ( Traits::mul(myA, myA, aa) && Traits::mul(myB, myB, bb) 
+	 && Traits::mul(myC, myD, cd) && Traits::mul(cd, Integer(4), cd) 
+	 && Traits::add(aa, bb, num) && Traits::sub(num, cd, num) )
+      {
+	double c = Traits::castToDouble(myC); 
+	return std::sqrt( Traits::castToDouble(num) / (4*c*c) ); 
+      }
+
+    double den = IntegerTraits<Integer>::castToDouble(4*myC*myC);
+    double v1 = IntegerTraits<Integer>::castToDouble(myA*myA) / den;
+    double v2 = IntegerTraits<Integer>::castToDouble(myB*myB) / den; 
+    double v3 = IntegerTraits<Integer>::castToDouble(myD)
+      / IntegerTraits<Integer>::castToDouble(myC); 
     return std::sqrt(v1 + v2 - v3); 
   }
 
@@ -153,8 +262,8 @@ public:
    */
   double getCenterX() const 
   { 
-    return DGtal::NumberTraits<Integer>::castToDouble(-myA) 
-      / DGtal::NumberTraits<Integer>::castToDouble(2*myC);  
+    return IntegerTraits<Integer>::castToDouble(-myA) 
+      / IntegerTraits<Integer>::castToDouble(my2C) + (double) myShift[0];  
   }
 
   /**
@@ -163,8 +272,8 @@ public:
    */
   double getCenterY() const 
   { 
-    return DGtal::NumberTraits<Integer>::castToDouble(-myB)
-      / DGtal::NumberTraits<Integer>::castToDouble(2*myC);
+    return IntegerTraits<Integer>::castToDouble(-myB)
+      / IntegerTraits<Integer>::castToDouble(my2C) + (double) myShift[1];
   }
 
   /**
@@ -174,10 +283,162 @@ public:
    */
   Coordinate getBottom() const 
   { 
+    if (myC < 0)
+      {
+	Discriminant xmax; 
+	return getBottomRow(xmax) + myShift[1]; 
+      }
     double y = getCenterY() - getRadius(); 
     return (Coordinate) std::ceil( y ); 
   }
 
+private: 
+  /**
+   * Computes exactly the range of the x-coordinates of 
+   * the digital points lying inside the circle on a given row
+   * (in the local frame), 
+   * since the point (x,y) is inside if and only if 
+   * (2|c|x - a)^2 + (2|c|y - b)^2 <= a^2 + b^2 - 4cd. 
+   * These quantities are of the order of a discriminant. 
+   * NB: the c-parameter must be negative. 
+   * @param aY y-coordinate of the row
+   * @param aXMin (returned) minimal x-coordinate
+   * @param aXMax (returned) maximal x-coordinate
+   * @return 'false' if there is no digital point inside
+   * the circle on this row, 'true' otherwise
+   */
+  bool getRow(const Discriminant& aY, Discriminant& aXMin, Discriminant& aXMax) const
+  {
+    typedef IntegerConversion<Discriminant, Integer> Conversion; 
+    const Discriminant& a = Conversion::cast(myA); 
+    const Discriminant& b = Conversion::cast(myB); 
+    Discriminant twoC = -Conversion::cast(my2C); 
+    Discriminant dy = twoC*aY - b; 
+    Discriminant m = a*a + b*b - 4*Conversion::cast(myC)*Conversion::cast(myD) - dy*dy; 
+    if (m < 0)
+      return false; 
+    Discriminant t = IntegerTraits<Discriminant>::isqrt(m); 
+    aXMin = -floorDivision(Discriminant(t - a), twoC); 
+    aXMax = floorDivision(Discriminant(a + t), twoC); 
+    return (aXMin <= aXMax); 
+  }
+
+  /**
+   * Computes exactly the lowest row containing a digital
+   * point inside the circle, starting from the lowest row 
+   * that intersects the circle (in the local frame). 
+   * NB: the c-parameter must be negative. 
+   * @param aXMax (returned) maximal x-coordinate 
+   * of the digital points of this row
+   * @return y-coordinate of the row
+   */
+  Coordinate getBottomRow(Discriminant& aXMax) const
+  {
+    typedef IntegerConversion<Discriminant, Integer> Conversion; 
+    const Discriminant& a = Conversion::cast(myA); 
+    const Discriminant& b = Conversion::cast(myB); 
+    Discriminant twoC = -Conversion::cast(my2C); 
+    //(2|c|y - b)^2 <= a^2 + b^2 - 4cd
+    Discriminant n = a*a + b*b - 4*Conversion::cast(myC)*Conversion::cast(myD); 
+    ASSERT( n >= 0 ); 
+    Discriminant s = IntegerTraits<Discriminant>::isqrt(n); 
+    Discriminant y = -floorDivision(Discriminant(s - b), twoC); 
+    Discriminant ymax = floorDivision(Discriminant(b + s), twoC); 
+    Discriminant xmin; 
+    while ( (y <= ymax) && (!getRow(y, xmin, aXMax)) )
+      y += 1; 
+    ASSERT( (y <= ymax) && "Error in getBottomRow of ExactRayIntersectableCircle: no digital point" ); 
+    return IntegerTraits<Discriminant>::castToInt64(y); 
+  }
+
+  /**
+   * Computes exactly the range of the digital points lying 
+   * inside the circle on the line {j w + t u | t}, where 
+   * u = (-n1, n0) (in the local frame, see getSupportingVertex). 
+   * The point p = j w + t u is inside if and only if 
+   * (m <n,p> - <n,(a,b)>)^2 + (m <u,p> - <u,(a,b)>)^2 <= |n|^2 (a^2 + b^2 - 4cd), 
+   * where m = 2|c|, since n and u are orthogonal and of same norm. 
+   * @param aN0 first coordinate of n
+   * @param aN1 second coordinate of n
+   * @param aWU dot product between w and u
+   * @param aJ level of the line, ie. <n,p> for all its points p
+   * @param aTMin (returned) minimal t
+   * @param aTMax (returned) maximal t
+   * @return 'false' if there is no digital point inside
+   * the circle on this line, 'true' otherwise
+   */
+  bool getLevelRange(const Discriminant& aN0, const Discriminant& aN1, const Discriminant& aWU, 
+		     const Discriminant& aJ, Discriminant& aTMin, Discriminant& aTMax) const
+  {
+    typedef IntegerConversion<Discriminant, Integer> Conversion; 
+    const Discriminant& a = Conversion::cast(myA); 
+    const Discriminant& b = Conversion::cast(myB); 
+    Discriminant m = -Conversion::cast(my2C); 
+    Discriminant nn = aN0*aN0 + aN1*aN1; 
+    Discriminant alpha = m*aJ - (aN0*a + aN1*b); 
+    Discriminant bu = aN0*b - aN1*a; 
+    Discriminant r = nn*(a*a + b*b - 4*Conversion::cast(myC)*Conversion::cast(myD)) - alpha*alpha; 
+    if (r < 0)
+      return false; 
+    Discriminant s = IntegerTraits<Discriminant>::isqrt(r); 
+    //|m (j <w,u> + t |u|^2) - <u,(a,b)>| <= s
+    Discriminant x = bu - m*aJ*aWU; 
+    aTMin = -floorDivision(Discriminant(s - x), Discriminant(m*nn)); 
+    aTMax = floorDivision(Discriminant(x + s), Discriminant(m*nn)); 
+    return (aTMin <= aTMax); 
+  }
+
+  /**
+   * Returns the digital point lying inside the circle that has 
+   * a maximal dot product with a primitive vector n, by scanning
+   * the levels downward (see getLevelRange), from the highest 
+   * level intersecting the circle. Since the chord of the highest
+   * level whose chord is not shorter than |n| contains a digital 
+   * point, at most about |n|^3 / (8 R) levels are scanned. 
+   * @param aN0 first coordinate of n
+   * @param aN1 second coordinate of n
+   * @param aIsLast 'true' to return the last point in 
+   * a counter-clockwise order if there are two such points, 
+   * 'false' to return the first one
+   * @return point in the local frame
+   */
+  Point getLevelVertex(const Coordinate& aN0, const Coordinate& aN1, bool aIsLast) const
+  {
+    typedef IntegerConversion<Discriminant, Integer> Conversion; 
+    typedef IntegerTraits<Discriminant> Traits; 
+    Discriminant m = -Conversion::cast(my2C); 
+    //w such that <n,w> = 1, reduced along u 
+    //so that |<w,u>| <= |u|^2 / 2
+    Coordinate s, t; 
+    extendedGreatestCommonDivisor(aN0, aN1, s, t); 
+    Discriminant n0 = toDiscriminant(aN0), n1 = toDiscriminant(aN1); 
+    Discriminant w0 = toDiscriminant(s), w1 = toDiscriminant(t); 
+    Discriminant nn = n0*n0 + n1*n1; 
+    Discriminant wu = n0*w1 - n1*w0; 
+    Discriminant k = floorDivision(Discriminant(2*wu + nn), Discriminant(2*nn)); 
+    w0 += k*n1; 
+    w1 -= k*n0; 
+    wu -= k*nn; 
+
+    //highest level intersecting the circle, 
+    //ie. (m j - <n,(a,b)>)^2 <= |n|^2 (a^2 + b^2 - 4cd)
+    Discriminant bn = n0*Conversion::cast(myA) + n1*Conversion::cast(myB); 
+    Discriminant r = nn*( Conversion::cast(myA)*Conversion::cast(myA) 
+			  + Conversion::cast(myB)*Conversion::cast(myB) 
+			  - 4*Conversion::cast(myC)*Conversion::cast(myD) ); 
+    Discriminant j = floorDivision(Discriminant(bn + Traits::isqrt(r)), m); 
+    Discriminant tmin, tmax; 
+    while (!getLevelRange(n0, n1, wu, j, tmin, tmax))
+      {
+	ASSERT( (m*j - bn)*(m*j - bn) <= r 
+		&& "Error in getLevelVertex of ExactRayIntersectableCircle: no digital point" ); 
+	j -= 1; 
+      }
+    //p = j w + t u
+    const Discriminant& tp = (aIsLast)?tmax:tmin; 
+    return Point( Traits::castToInt64( Discriminant(j*w0 - tp*n1) ), 
+		  Traits::castToInt64( Discriminant(j*w1 + tp*n0) ) ); 
+  }
 
 public: 
   ///////////////////// main methods ///////////////////
@@ -190,10 +451,127 @@ public:
    */
   Value operator()(const Point& aPoint) const
   {
-    Integer x = aPoint[0]; 
-    Integer y = aPoint[1];
-    Integer z = x*x + y*y;  
-    return (myA*aPoint[0] + myB*aPoint[1] + myC*z + myD); 
+    typedef IntegerConversion<Value, Integer> Conversion; 
+    Value x = toValue(aPoint[0] - myShift[0]); 
+    Value y = toValue(aPoint[1] - myShift[1]);
+    Value z = x*x + y*y;  
+    return ( Conversion::cast(myA)*x + Conversion::cast(myB)*y 
+	     + Conversion::cast(myC)*z + Conversion::cast(myD) ); 
+  }
+
+  /**
+   * Class implementing a cursor moving along a digital ray, 
+   * which updates the value of the function by finite 
+   * differences (two additions per step), since the value
+   * at aPoint + k * aDirection is a quadratic polynomial in k.
+   */
+  class RayCursor
+  {
+  private: 
+    /////////////////////// members /////////////////////
+    Point myPoint;        /* current point */
+    Vector myDirection;   /* ray direction */
+    Value myValue;        /* value at the current point */
+    Value myDelta;        /* value at the next point minus value at the current point */
+    Value mySecondDelta;  /* constant second difference, ie. 2c|aDirection|^2 */
+
+  public:
+    ///////////////////// standard services /////////////
+    /**
+     * Default constructor
+     */
+    RayCursor(): myPoint(0,0), myDirection(0,0), myValue(0), myDelta(0), mySecondDelta(0) {}
+
+    /**
+     * Standard constructor
+     * @param aPoint current point
+     * @param aDirection ray direction
+     * @param aValue value at @a aPoint
+     * @param aDelta first difference at @a aPoint
+     * @param aSecondDelta second difference
+     */
+    RayCursor(const Point& aPoint, const Vector& aDirection, 
+	      const Value& aValue, const Value& aDelta, const Value& aSecondDelta)
+      : myPoint(aPoint), myDirection(aDirection), 
+	myValue(aValue), myDelta(aDelta), mySecondDelta(aSecondDelta) {}
+
+    ///////////////////// main methods ///////////////////
+    /**
+     * @return current point
+     */
+    const Point& point() const { return myPoint; }
+
+    /**
+     * @return value at the current point
+     */
+    Value value() const { return myValue; }
+
+    /**
+     * @return value at the next point along the ray
+     */
+    Value nextValue() const { return myValue + myDelta; }
+
+    /**
+     * Moves the cursor to the next point along the ray
+     */
+    void advance()
+    {
+      myPoint += myDirection; 
+      myValue += myDelta; 
+      myDelta += mySecondDelta; 
+    }
+  }; 
+
+  /**
+   * @param aPoint any point
+   * @param aDirection ray direction
+   * @return cursor lying at @a aPoint and moving along @a aDirection
+   */
+  RayCursor cursor(const Point& aPoint, const Vector& aDirection) const
+  {
+    typedef IntegerConversion<Value, Integer> Conversion; 
+    Value x = toValue(aPoint[0] - myShift[0]); 
+    Value y = toValue(aPoint[1] - myShift[1]);
+    Value d0 = toValue(aDirection[0]); 
+    Value d1 = toValue(aDirection[1]);
+    Value dd = Conversion::cast(myC)*(d0*d0 + d1*d1); 
+    //f(p+d) - f(p) = a d0 + b d1 + 2c p.d + c|d|^2
+    Value delta = Conversion::cast(myA)*d0 + Conversion::cast(myB)*d1 
+      + Conversion::cast(my2C)*(x*d0 + y*d1) + dd; 
+    return RayCursor(aPoint, aDirection, (*this)(aPoint), delta, 2*dd); 
+  }
+
+private:
+  /**
+   * Conversion of a coordinate into the parameter type, 
+   * which may not be constructible from any builtin integer
+   * (eg. DGtal::BigInteger from long long). 
+   * @param x any coordinate
+   * @return @a x as an integer of type Integer
+   */
+  static Integer toInteger(const Coordinate& x)
+  {
+    return IntegerTraits<Integer>::castFromInt64( IntegerTraits<Coordinate>::castToInt64(x) ); 
+  }
+
+  /**
+   * Conversion of a coordinate into the discriminant type
+   * @param x any coordinate
+   * @return @a x as an integer of type Discriminant
+   */
+  static Discriminant toDiscriminant(const Coordinate& x)
+  {
+    return IntegerTraits<Discriminant>::castFromInt64( IntegerTraits<Coordinate>::castToInt64(x) ); 
+  }
+
+  /**
+   * Conversion of a coordinate into the value type
+   * @param x any coordinate
+   * @return @a x as an integer of type Value
+   */
+  static Value toValue(const Coordinate& x)
+  {
+    return IntegerTraits<Value>::castFromInt64( IntegerTraits<Coordinate>::castToInt64(x) ); 
   }
 
 private:
@@ -220,7 +598,7 @@ private:
     Coordinate qStart = 0;
     Coordinate qStop  = qmax;
     Point pStart = aPoint; 
-    Point pStop = aPoint + aDir*qmax; 
+    Point pStop = aPoint.plusScaled(aDir, qmax); 
 
     Coordinate qMid;
     Point pMid, pMid1; 
@@ -231,8 +609,8 @@ private:
       {
 	// middle between qStart and qStop
 	qMid = (qStart + qStop)/2;
-	pMid = aPoint + aDir*qMid;
-	pMid1 = aPoint + aDir*(qMid+1) ;
+	pMid = aPoint.plusScaled(aDir, qMid);
+	pMid1 = aPoint.plusScaled(aDir, qMid+1) ;
  
 	// inclusion tests
 	if ( aPredicate( (*this)(pMid)) )
@@ -252,6 +630,70 @@ private:
     return(qStart);
   }
 
+  /**
+   * Closed-form ray casting, used when the polynomial 
+   * f(q) = @a aEq q^2 + @a bEq q + @a cEq, which is equal to
+   * the value of the function at @a aPoint + q * @a aDir, 
+   * has a negative leading coefficient and two distinct 
+   * roots q1 < q2. The floor of the roots are computed from 
+   * the integer square root of the discriminant and 
+   * corrected by at most one step, so that only a constant 
+   * number of evaluations is required. 
+   * @param aPoint source of the ray casting (not on the circle)
+   * @param aDir direction of the ray casting
+   * @param aEq leading coefficient (negative)
+   * @param bEq linear coefficient
+   * @param cEq constant coefficient (not zero)
+   * @param aDelta positive discriminant
+   * @param aQuotient returned integer, equal to 
+   * the floor of q2 if @a aPoint is inside and to
+   * the floor of q1 if @a aPoint is outside (or to its 
+   * successor if it is the only digital point of the circle)
+   * @return 'false' if the ray does not go through
+   * the circle, 'true' otherwise
+   */
+  bool closedFormDray(const Point& aPoint, const Vector& aDir, 
+		      const Value& aEq, const Value& bEq, const Value& cEq, 
+		      const Discriminant& aDelta, Coordinate& aQuotient) const
+  {
+    typedef IntegerTraits<Value> Traits; 
+    Value twoA = -2*aEq; 
+    //the square root of the discriminant fits in a value
+    Value s = IntegerConversion<Value, Discriminant>::cast( IntegerTraits<Discriminant>::isqrt(aDelta) ); 
+    if (cEq < 0)
+      { //aPoint is strictly outside the circle
+	if (bEq <= 0) 
+	  return false; //both roots are negative
+	//upper bound of the floor of q1, which is not
+	//greater than the abscissa of the vertex
+	Coordinate q = Traits::castToInt64( floorDivision(Value(bEq - s), twoA) ); 
+	Value v = (*this)(aPoint.plusScaled(aDir, q)); 
+	if (v > 0) 
+	  {
+	    q--; 
+	    v = (*this)(aPoint.plusScaled(aDir, q)); 
+	  }
+	if (v < 0)
+	  { //q1 is not an integer
+	    Value v1 = (*this)(aPoint.plusScaled(aDir, q+1)); 
+	    if (v1 < 0) 
+	      return false; //no digital point between q1 and q2
+	    else if (v1 == 0)
+	      q++; //only one digital point, equal to q2
+	  }
+	aQuotient = q; 
+      }
+    else
+      { //aPoint is strictly inside the circle
+	//lower bound of the floor of q2
+	Coordinate q = Traits::castToInt64( floorDivision(Value(bEq + s), twoA) ); 
+	if ( (*this)(aPoint.plusScaled(aDir, q+1)) >= 0 )
+	  q++; 
+	aQuotient = q; 
+      }
+    return true; 
+  }
+
 public: 
   /**
    * Intersection between the circle and the digital ray
@@ -270,25 +712,31 @@ public:
   {
     
     //We look for the intersection between  aS + aQ * aD and the circle
-    Integer aD0 = aDirection[0];
-    Integer aD1 = aDirection[1];
-    
-    Integer aS0 = aStartingPoint[0];
-    Integer aS1 = aStartingPoint[1];    
+    typedef IntegerConversion<Value, Integer> Conversion; 
+    Value aD0 = toValue(aDirection[0]);
+    Value aD1 = toValue(aDirection[1]);
     
+    Value aS0 = toValue(aStartingPoint[0] - myShift[0]);
+    Value aS1 = toValue(aStartingPoint[1] - myShift[1]);    
     
-    Integer aEq = myC*(aD0*aD0 + aD1*aD1);
-    Integer bEq = myA*aD0 + myB*aD1 + 2*myC*aS0*aD0 + 2*myC*aS1*aD1;
-    Integer cEq = myA*aS0 + myB*aS1 + myC*aS0*aS0 + myC*aS1*aS1 + myD;  
+    const Value& c = Conversion::cast(myC); 
+    Value aEq = c*(aD0*aD0 + aD1*aD1);
+    Value bEq = Conversion::cast(myA)*aD0 + Conversion::cast(myB)*aD1 
+      + Conversion::cast(my2C)*(aS0*aD0 + aS1*aD1);
+    Value cEq = Conversion::cast(myA)*aS0 + Conversion::cast(myB)*aS1 
+      + c*(aS0*aS0 + aS1*aS1) + Conversion::cast(myD);  
 
-    Integer Delta = bEq*bEq - 4*aEq*cEq;
+    typedef IntegerConversion<Discriminant, Value> Widening; 
+    Discriminant Delta = Widening::cast(bEq)*Widening::cast(bEq) 
+      - 4*Widening::cast(aEq)*Widening::cast(cEq);
 
     //Delta = 0 : 1 solution
     // aS+aQ*aD is a tangent to the circle
-    if ( (Delta == 0) && (-bEq/(2*aEq) >= 0) )
+    // (at a digital point only if the solution is an integer)
+    if ( (Delta == 0) && (-bEq/(2*aEq) >= 0) && (bEq % (2*aEq) == 0) )
       {
-	aQuotient = DGtal::NumberTraits<Integer>::castToInt64_t(-bEq /(2*aEq));
-	aClosest = aStartingPoint + aDirection*aQuotient;
+	aQuotient = IntegerTraits<Value>::castToInt64(-bEq /(2*aEq));
+	aClosest = aStartingPoint.plusScaled(aDirection, aQuotient);
 	return true;
       }
     // Delta > 0 : 2 solutions
@@ -300,6 +748,16 @@ public:
 	    aClosest = aStartingPoint;
 	    return true;
 	  }
+	else if ( aEq < 0 )
+	  { // the solutions are directly computed
+	    if ( closedFormDray(aStartingPoint, aDirection, aEq, bEq, cEq, Delta, aQuotient) )
+	      {
+		aClosest = aStartingPoint.plusScaled(aDirection, aQuotient);
+		return true;
+	      }
+	    else 
+	      return false; 
+	  }
 	else 
 	  {  
 	    if ( cEq < 0)
@@ -310,16 +768,16 @@ public:
 		    // We pick the smallest one by dichotomic search
 		    //this predicate is true iff the input value is <= 0
 		    using namespace DGtal; 
-		    Thresholder<Integer, true, true> predicate(0);
+		    Thresholder<Value, true, true> predicate(0);
 		    
-		    Coordinate max = DGtal::NumberTraits<Integer>::castToInt64_t(-bEq/(2*aEq)); 
+		    Coordinate max = IntegerTraits<Value>::castToInt64(-bEq/(2*aEq)); 
 		    
 
 		    //inclusion tests around the minimum (-bEq/(2*aEq))
-		    Point pMax = aStartingPoint + aDirection*max; 
-		    Integer pMaxValue = (*this)(pMax);  
-		    Point pMax1 = aStartingPoint + aDirection*(max+1);
-		    Integer pMaxValue1 = (*this)(pMax1);  
+		    Point pMax = aStartingPoint.plusScaled(aDirection, max); 
+		    Value pMaxValue = (*this)(pMax);  
+		    Point pMax1 = aStartingPoint.plusScaled(aDirection, max+1);
+		    Value pMaxValue1 = (*this)(pMax1);  
 		    if ( pMaxValue < 0 ) 
 		      { //if pMax is strictly outside the shape
 			if ( pMaxValue1 < 0 )
@@ -342,7 +800,7 @@ public:
 			  aQuotient = dichotomicSearch(aStartingPoint, aDirection, max, predicate);
 		      }
 
-		    aClosest = aStartingPoint + aDirection*aQuotient;
+		    aClosest = aStartingPoint.plusScaled(aDirection, aQuotient);
 		    return true;
 		  }
 	      }
@@ -351,11 +809,11 @@ public:
 		// We pick the positive solution by dichotomic search
 		//this predicate is true iff the input value is >= 0
 		using namespace DGtal;
-		Thresholder<Integer, false, true> predicate(0); 
+		Thresholder<Value, false, true> predicate(0); 
 		//a trivial upper bound is the circle diameter
 		Coordinate diameter = 2 * (Coordinate) std::ceil( getRadius() ) + 1; 
 		aQuotient = dichotomicSearch(aStartingPoint, aDirection, diameter, predicate); 
-		aClosest = aStartingPoint + aDirection*aQuotient;
+		aClosest = aStartingPoint.plusScaled(aDirection, aQuotient);
 		return true;
 	      }
 	  }
@@ -373,12 +831,19 @@ public:
    */
   Point getConvexHullVertex() const 
   { 
+    if (myC < 0)
+      { //exact computation
+	Discriminant xmax; 
+	Coordinate y = getBottomRow(xmax); 
+	return Point( IntegerTraits<Discriminant>::castToInt64(xmax), y ) + myShift; 
+      }
+
     //computation of one integer point, 
     //inside the circle and having min y-coordinate
     Point startingPoint; 
  
     Coordinate ymin = getBottom();
-    Coordinate x = (Coordinate) DGtal::NumberTraits<Integer>::castToInt64_t(-myA/(2*myC)); 
+    Coordinate x = (Coordinate) IntegerTraits<Integer>::castToInt64(-myA/my2C) + myShift[0]; 
     Point ptf(x, ymin);
     if ( this->operator()( ptf ) < 0 )
       { //if ptf is outside the circle
@@ -406,6 +871,126 @@ public:
       } 
   }
 
+  /**
+   * Returns the four vertices of the convex hull of the digital 
+   * points lying inside the circle that are extremal in the axis
+   * directions, in a counter-clockwise order: 
+   * - the vertex returned by getConvexHullVertex (min y, then max x), 
+   * - the one of max x, then max y, 
+   * - the one of max y, then min x, 
+   * - the one of min x, then min y. 
+   * Since a quarter turn maps the digital plane onto itself, 
+   * the k-th vertex is the image by k quarter turns of the vertex 
+   * returned by getConvexHullVertex for the circle rotated by 
+   * -k quarter turns, whose parameters are exactly computed. 
+   * NB: some vertices may be equal for small circles. 
+   * @param res output iterator that stores the four vertices
+   */
+  template <typename OutputIterator>
+  void getExtremalVertices(OutputIterator res) const
+  {
+    Integer a = myA, b = myB; 
+    Point shift = myShift; 
+    for (int k = 0; k < 4; k++)
+      {
+	ExactRayIntersectableCircle rotated(a, b, myC, myD, shift); 
+	Point p = rotated.getConvexHullVertex(); 
+	for (int i = 0; i < k; i++)
+	  p = Point(-p[1], p[0]); 
+	*res++ = p; 
+	//rotation by -pi/2: f(x,y) becomes f(-y,x)
+	Integer tmp = a; 
+	a = b; 
+	b = -tmp; 
+	shift = Point(shift[1], -shift[0]); 
+      }
+  }
+
+  /**
+   * Returns a vertex of the convex hull of the digital points
+   * lying inside the circle that supports a given direction, 
+   * ie. that has a maximal dot product with @a aNormal. 
+   * If two vertices do (the ones of an edge orthogonal to 
+   * @a aNormal), the last one in a counter-clockwise order 
+   * is returned if @a aIsLast is 'true', the first one otherwise, 
+   * so that getSupportingVertex(Vector(0,-1)) is equal to 
+   * getConvexHullVertex(). 
+   * 
+   * The levels orthogonal to a short direction are scanned exactly 
+   * (see getLevelVertex), but the number of scanned levels grows as 
+   * the cube of its norm. Hence, the direction n of @a aNormal is 
+   * bracketed by two primitive vectors e1, e2 such that det(e1,e2) = 1, 
+   * starting from the axis-aligned vectors of its quadrant and refined
+   * as in the Stern-Brocot tree, with steps doubled along a same side 
+   * as in a continued fraction expansion, until the last vertex 
+   * supporting e1 is equal to the first vertex supporting e2: 
+   * this vertex supports all the directions between e1 and e2. 
+   * Since the edges of the convex hull with long normals are rare, 
+   * the refinement stops with short vectors, after a number of steps
+   * that is logarithmic in the norm of @a aNormal, each of which 
+   * scans the levels of one refined vector only. No vertex of the 
+   * convex hull is enumerated. 
+   * NB: the c-parameter must be negative. 
+   * @param aNormal any non-zero vector
+   * @param aIsLast 'true' to return the last vertex of an edge
+   * orthogonal to @a aNormal, 'false' to return the first one
+   * @return vertex of the convex hull. 
+   */
+  Point getSupportingVertex(const Vector& aNormal, bool aIsLast = true) const
+  {
+    ASSERT( myC < 0 ); 
+    ASSERT( (aNormal[0] != 0) || (aNormal[1] != 0) ); 
+    Coordinate g = greatestCommonDivisor(aNormal[0], aNormal[1]); 
+    Vector n(aNormal[0]/g, aNormal[1]/g); 
+
+    //quadrant of n, ie. n = alpha e1 + beta e2 with alpha > 0 and beta >= 0
+    Vector e1(1,0), e2(0,1); 
+    while ( (n[0]*e2[1] - n[1]*e2[0] <= 0) || (e1[0]*n[1] - e1[1]*n[0] < 0) )
+      {
+	e1 = Vector(-e1[1], e1[0]); 
+	e2 = Vector(-e2[1], e2[0]); 
+      }
+    Coordinate alpha = n[0]*e2[1] - n[1]*e2[0]; 
+    Coordinate beta = e1[0]*n[1] - e1[1]*n[0]; 
+    Coordinate step = 1; 
+    bool wasFirstSide = true; 
+    //last vertex supporting e1 and first vertex supporting e2, 
+    //only updated when the corresponding vector is refined
+    Point v1, v2; 
+    if ( (beta != 0) && (alpha != beta) )
+      {
+	v1 = getLevelVertex(e1[0], e1[1], true); 
+	v2 = getLevelVertex(e2[0], e2[1], false); 
+      }
+    while ( (beta != 0) && (alpha != beta) )
+      {
+	if (v1 == v2)
+	  return v1 + myShift; 
+	//n lies between e1 and e1 + e2 if alpha > beta
+	bool isFirstSide = (alpha > beta); 
+	step = (isFirstSide == wasFirstSide)?(2*step):1; 
+	wasFirstSide = isFirstSide; 
+	if (isFirstSide)
+	  { //e2 <- e2 + q e1
+	    Coordinate q = std::min(step, Coordinate( (alpha - 1) / beta )); 
+	    e2 = Vector(e2[0] + q*e1[0], e2[1] + q*e1[1]); 
+	    alpha -= q*beta; 
+	    if (alpha != beta)
+	      v2 = getLevelVertex(e2[0], e2[1], false); 
+	  }
+	else
+	  { //e1 <- e1 + q e2
+	    Coordinate q = std::min(step, Coordinate( (beta - 1) / alpha )); 
+	    e1 = Vector(e1[0] + q*e2[0], e1[1] + q*e2[1]); 
+	    beta -= q*alpha; 
+	    if ( (beta != 0) && (alpha != beta) )
+	      v1 = getLevelVertex(e1[0], e1[1], true); 
+	  }
+      }
+    //n is equal to e1 or e1 + e2
+    return getLevelVertex(n[0], n[1], aIsLast) + myShift; 
+  }
+
 }; 
 #endif
 
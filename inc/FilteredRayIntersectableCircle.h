@@ -0,0 +1,396 @@
+#ifndef FilteredRayIntersectableCircle_h
+#define FilteredRayIntersectableCircle_h
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "IntegerHelpers.h"
+
+/**
+ * Class implementing a circle that is 'ray intersectable',
+ * whose computations are first performed with doubles and
+ * certified by a rigorous error bound (floating-point filter).
+ * The exact circle is only called when the sign of the
+ * function or the result of the ray casting is uncertain,
+ * so that the results are always equal to the ones of
+ * the exact circle.
+ *
+ * The function is evaluated in the local frame of the
+ * exact circle parameters (see ExactRayIntersectableCircle::normalize),
+ * so that the filter succeeds whatever the location of the circle.
+ * A ray casting is certified if the signs at the returned point
+ * and at its successor along the ray are certified. Otherwise,
+ * and when there is no intersection, the exact circle is called.
+ *
+ * The number of calls answered by the filter and by the
+ * exact circle are counted.
+ *
+ * @tparam TShape a model of exact ray intersectable circle
+ * (ExactRayIntersectableCircle or AdaptiveRayIntersectableCircle).
+ *
+ * This class is a model of point functor and of ray intersectable shape
+ */
+template <typename TShape>
+class FilteredRayIntersectableCircle
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TShape Shape;
+  typedef typename Shape::Point Point;
+  typedef typename Shape::Vector Vector;
+  typedef typename Shape::Coordinate Coordinate;
+  typedef typename Shape::Integer Integer;
+  typedef typename Shape::RayCursor RayCursor;
+  /**
+   * Only the sign of the function is returned
+   */
+  typedef int Value;
+
+private:
+  /////////////////////// members /////////////////////
+  /**
+   * Exact circle
+   */
+  Shape myShape;
+
+  /**
+   * Circle parameters rounded to doubles
+   * (in the local frame of the exact circle)
+   */
+  double myA, myB, myC, myD;
+
+  /**
+   * Origin of the local frame
+   */
+  Point myShift;
+
+  /**
+   * 'true' if the rounded parameters are finite
+   */
+  bool myIsFinite;
+
+  /**
+   * Number of calls answered by the filter and
+   * by the exact circle
+   */
+  mutable unsigned long long myNbFilteredCalls, myNbExactCalls;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Constructor
+   * @param aShape exact circle
+   */
+  FilteredRayIntersectableCircle(const Shape& aShape)
+    : myShape(aShape), myNbFilteredCalls(0), myNbExactCalls(0)
+  {
+    init();
+  }
+
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  FilteredRayIntersectableCircle(const FilteredRayIntersectableCircle& other)
+    : myShape(other.myShape), myA(other.myA), myB(other.myB), myC(other.myC), myD(other.myD),
+      myShift(other.myShift), myIsFinite(other.myIsFinite),
+      myNbFilteredCalls(other.myNbFilteredCalls), myNbExactCalls(other.myNbExactCalls) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  FilteredRayIntersectableCircle& operator=(const FilteredRayIntersectableCircle& other)
+  {
+    if (&other != this)
+      {
+	myShape = other.myShape;
+	myA = other.myA;
+	myB = other.myB;
+	myC = other.myC;
+	myD = other.myD;
+	myShift = other.myShift;
+	myIsFinite = other.myIsFinite;
+	myNbFilteredCalls = other.myNbFilteredCalls;
+	myNbExactCalls = other.myNbExactCalls;
+      }
+    return *this;
+  }
+
+  /**
+   * Default destructor
+   */
+  ~FilteredRayIntersectableCircle() {}
+
+private:
+  /**
+   * Rounds the parameters of the exact circle to doubles
+   */
+  void init()
+  {
+    typedef IntegerTraits<Integer> Traits;
+    myA = Traits::castToDouble( myShape.a() );
+    myB = Traits::castToDouble( myShape.b() );
+    myC = Traits::castToDouble( myShape.c() );
+    myD = Traits::castToDouble( myShape.d() );
+    myShift = myShape.getShift();
+    myIsFinite = ( std::isfinite(myA) && std::isfinite(myB)
+		   && std::isfinite(myC) && std::isfinite(myD) );
+  }
+
+public:
+  ///////////////////// read access ///////////////////
+  /**
+   * Exact circle accessor
+   * @return exact circle
+   */
+  const Shape& getShape() const { return myShape; }
+
+  /**
+   * @return number of calls answered by the filter
+   */
+  unsigned long long getNbFilteredCalls() const { return myNbFilteredCalls; }
+
+  /**
+   * @return number of calls answered by the exact circle
+   */
+  unsigned long long getNbExactCalls() const { return myNbExactCalls; }
+
+  /**
+   * Resets the counters
+   */
+  void resetCounters() const { myNbFilteredCalls = myNbExactCalls = 0; }
+
+  /**
+   * Origin of the local frame accessor
+   * @return the point that the parameters are relative to
+   */
+  Point getShift() const { return myShift; }
+
+  /**
+   * a-parameter accessor (in the local frame)
+   * @return a-parameter.
+   */
+  Integer a() const { return myShape.a(); }
+
+  /**
+   * b-parameter accessor (in the local frame)
+   * @return b-parameter.
+   */
+  Integer b() const { return myShape.b(); }
+
+  /**
+   * c-parameter accessor (in the local frame)
+   * @return c-parameter.
+   */
+  Integer c() const { return myShape.c(); }
+
+  /**
+   * d-parameter accessor (in the local frame)
+   * @return d-parameter.
+   */
+  Integer d() const { return myShape.d(); }
+
+  /**
+   * radius accessor
+   * @return circle radius
+   */
+  double getRadius() const { return myShape.getRadius(); }
+
+  /**
+   * center x-coordinate accessor
+   * @return x-coordinate of the circle center.
+   */
+  double getCenterX() const { return myShape.getCenterX(); }
+
+  /**
+   * center y-coordinate accessor
+   * @return y-coordinate of the circle center.
+   */
+  double getCenterY() const { return myShape.getCenterY(); }
+
+  /**
+   * Returns the minimal y-coordinate of the digital points
+   * lying inside the circle.
+   * @return minimal y-coordinate.
+   */
+  Coordinate getBottom() const { return myShape.getBottom(); }
+
+private:
+  /**
+   * Evaluates the sign of the function with doubles.
+   * The coordinates (in the local frame) and the products
+   * are bounded, so that each of the (at most) ten
+   * roundings, including the ones of the parameters,
+   * has a relative error of at most 2^-53 with respect to
+   * the sum M of the absolute values of the terms.
+   * The error is thus bounded by 16 * 2^-53 * M.
+   * @param aPoint any point
+   * @param aSign (returned) sign of the function at @a aPoint
+   * @return 'true' if the sign is certified, 'false' otherwise
+   */
+  bool filteredSign(const Point& aPoint, Value& aSign) const
+  {
+    if (!myIsFinite)
+      return false;
+    Point p = aPoint - myShift;
+    //coordinates exactly representable
+    const double bound = 4503599627370496.0; //2^52
+    double x = (double) p[0];
+    double y = (double) p[1];
+    if ( (std::abs(x) >= bound) || (std::abs(y) >= bound) )
+      return false;
+    double z = x*x + y*y;
+    double v = myA*x + myB*y + myC*z + myD;
+    double m = std::abs(myA*x) + std::abs(myB*y) + std::abs(myC)*z + std::abs(myD);
+    double error = 16.0 * std::numeric_limits<double>::epsilon() / 2.0 * m;
+    if ( !std::isfinite(error) )
+      return false;
+    if (v > error)
+      aSign = 1;
+    else if (v < -error)
+      aSign = -1;
+    else
+      return false;
+    return true;
+  }
+
+  /**
+   * @param x any integer
+   * @return sign of @a x
+   */
+  template <typename T>
+  static Value sign(const T& x)
+  {
+    return (x > 0)?1:( (x < 0)?-1:0 );
+  }
+
+public:
+  ///////////////////// main methods ///////////////////
+  /**
+   * Function operator
+   * @param aPoint any point
+   * @return 0 if @a aPoint is on the circle,
+   * -1 if @a aPoint is outside
+   * 1 if @a aPoint is inside
+   */
+  Value operator()(const Point& aPoint) const
+  {
+    Value s;
+    if ( filteredSign(aPoint, s) )
+      {
+	myNbFilteredCalls++;
+	return s;
+      }
+    myNbExactCalls++;
+    return sign( myShape(aPoint) );
+  }
+
+  /**
+   * @param aPoint any point
+   * @param aDirection ray direction
+   * @return cursor of the exact circle lying at @a aPoint
+   * and moving along @a aDirection
+   */
+  RayCursor cursor(const Point& aPoint, const Vector& aDirection) const
+  {
+    return myShape.cursor(aPoint, aDirection);
+  }
+
+  /**
+   * Intersection between the circle and the digital ray.
+   * A candidate quotient is computed with doubles
+   * from the roots of the polynomial q -> f(aStartingPoint + q aDirection),
+   * then it is returned if the signs at the candidate point and
+   * its successor certify that it is equal to the exact one.
+   *
+   * @param aStartingPoint point from which the ray is emanating
+   * @param aDirection ray direction
+   * @param returned maximal integer such that
+   * @a aStartingPoint + @a aQuotient * @a aDirection lies close
+   * (but on the same side) to the circle
+   * @param returned point equal to @a aStartingPoint + @a aQuotient * @a aDirection
+   *
+   * @return 'true' if the ray and the circle instercest, 'false' otherwise
+   * @see ExactRayIntersectableCircle::dray
+   */
+  bool dray(const Point& aStartingPoint, const Vector& aDirection,
+	    Coordinate& aQuotient, Point& aClosest) const
+  {
+    Value s0;
+    if ( (myC < 0) && (filteredSign(aStartingPoint, s0)) )
+      {
+	Point p = aStartingPoint - myShift;
+	double x = (double) p[0], y = (double) p[1];
+	double d0 = (double) aDirection[0], d1 = (double) aDirection[1];
+	//polynomial aEq q^2 + bEq q + cEq, with aEq < 0
+	double aEq = myC*(d0*d0 + d1*d1);
+	double bEq = myA*d0 + myB*d1 + 2*myC*(x*d0 + y*d1);
+	double cEq = myA*x + myB*y + myC*(x*x + y*y) + myD;
+	double delta = bEq*bEq - 4*aEq*cEq;
+	if (delta > 0)
+	  {
+	    //the greatest root if inside, the smallest one otherwise
+	    double root = (s0 > 0)?( (-bEq - std::sqrt(delta)) / (2*aEq) )
+	      :( (-bEq + std::sqrt(delta)) / (2*aEq) );
+	    //the candidate points must not overflow
+	    double limit = std::min( 4503599627370496.0, //2^52
+				     (double) std::numeric_limits<Coordinate>::max() / 2 );
+	    double reach = (root + 1) * std::max( std::abs(d0), std::abs(d1) );
+	    double start = std::max( std::abs( (double) aStartingPoint[0] ),
+				     std::abs( (double) aStartingPoint[1] ) );
+	    if ( (root >= 0) && (reach + start < limit) )
+	      {
+		Coordinate q = (Coordinate) std::floor(root);
+		Value s1, s2;
+		//inside: q and q+1 on either side, ie. q = floor(q2)
+		//outside: q outside and q+1 inside, ie. q = floor(q1)
+		if ( (filteredSign(aStartingPoint.plusScaled(aDirection, q), s1))
+		     && (filteredSign(aStartingPoint.plusScaled(aDirection, q+1), s2))
+		     && (s1 == s0) && (s2 == -s0) )
+		  {
+		    myNbFilteredCalls++;
+		    aQuotient = q;
+		    aClosest = aStartingPoint.plusScaled(aDirection, q);
+		    return true;
+		  }
+	      }
+	  }
+      }
+    myNbExactCalls++;
+    return myShape.dray(aStartingPoint, aDirection, aQuotient, aClosest);
+  }
+
+  /**
+   * Returns a vertex of the convex hull of the digital points
+   * lying inside the circle, such that it has a minimal y-coordinate,
+   * and among the digital points of minimal y-coordinate, it has
+   * a maximal x-coordinate.
+   * @return vertex of the convex hull.
+   */
+  Point getConvexHullVertex() const { return myShape.getConvexHullVertex(); }
+
+  /**
+   * Returns the four vertices of the convex hull that are 
+   * extremal in the axis directions, in a counter-clockwise order
+   * @param res output iterator that stores the four vertices
+   * @see ExactRayIntersectableCircle::getExtremalVertices
+   */
+  template <typename OutputIterator>
+  void getExtremalVertices(OutputIterator res) const { myShape.getExtremalVertices(res); }
+
+  /**
+   * Returns a vertex of the convex hull that supports a given direction
+   * @param aNormal any non-zero vector
+   * @param aIsLast 'true' to return the last vertex of an edge
+   * orthogonal to @a aNormal, 'false' to return the first one
+   * @return vertex of the convex hull. 
+   * @see ExactRayIntersectableCircle::getSupportingVertex
+   */
+  Point getSupportingVertex(const Vector& aNormal, bool aIsLast = true) const 
+  { return myShape.getSupportingVertex(aNormal, aIsLast); }
+
+};
+#endif
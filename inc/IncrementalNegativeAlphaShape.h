@@ -2,9 +2,14 @@
 #define IncrementalNegativeAlphaShape_h
 
 #include<cmath>
+#include<vector>
+#include<iterator>
+#include<algorithm>
 
 #include "BasicHelpers.h"
 #include "ConvexHullHelpers.h"
+#include "DiscSymmetry.h"
+#include "VertexRange.h"
 
 #include"CircumcircleRadiusPredicate.h"
 
@@ -17,6 +22,11 @@
  * a ray emanating from a given point along a given direction
  * is computable.
  *
+ * If the set of digital points lying inside the shape
+ * is symmetric (see DiscSymmetry), only the vertices of 
+ * a fundamental sector are retrieved by the method all, 
+ * the other ones being obtained by symmetry. 
+ *
  * @tparam TShape a model of ray-intersectable shape.
  * @tparam TPredicate a model of ternary predicate: 
  * given three points, the operator() returns a bool.  
@@ -47,6 +57,12 @@ private:
    */
   const Predicate& myPredicate; 
 
+  /**
+   * 'true' if the symmetries of the shape are used
+   * by the method all (see setSymmetry)
+   */
+  bool myIsSymmetric; 
+
 public:
   ///////////////////// standard services /////////////
   /**
@@ -55,7 +71,7 @@ public:
    * @param aPredicate any predicate
    */
   IncrementalNegativeAlphaShape(const Shape& aShape, const Predicate& aPredicate)
-    : myShape(aShape), myPredicate(aPredicate) {}
+    : myShape(aShape), myPredicate(aPredicate), myIsSymmetric(true) {}
 
 private:
   /**
@@ -87,6 +103,13 @@ public:
    */
   ~IncrementalNegativeAlphaShape() {}
 
+  /**
+   * Enables or disables the use of the symmetries 
+   * of the shape by the method all (enabled by default)
+   * @param aFlag 'true' to enable the use of the symmetries
+   */
+  void setSymmetry(bool aFlag) { myIsSymmetric = aFlag; }
+
 
   ///////////////////// main methods ///////////////////
 public:
@@ -105,14 +128,36 @@ public:
    * equal to aQk*aConvM1 + aConvM2
    * @return maximal integer such that the predicate is true
    */
-  int dichotomicSearch(const Point& aPoint,
-		       const Point aConvM2, const Point aConvM1, const int aQk)
+  Coordinate dichotomicSearch(const Point& aPoint,
+			      const Point aConvM2, const Point aConvM1, const Coordinate aQk)
+  {
+    return dichotomicSearch(myPredicate, aPoint, aConvM2, aConvM1, aQk); 
+  }
+
+  /**
+   * Dichotomic search procedure for a given predicate 
+   * (see above), which is shared by the alpha-shapes 
+   * of several predicates (see MultiNegativeAlphaShape)
+   *
+   * @param aPredicate any predicate
+   * @param aPoint origin of the local domain of computation
+   * @param aConvM2 (k-2)-th convergent
+   * @param aConvM1 (k-1)-th convergent
+   * @param aQk integer such that the k-th convergent is
+   * equal to aQk*aConvM1 + aConvM2
+   * @return maximal integer such that @a aPredicate is true
+   */
+  static Coordinate dichotomicSearch(const Predicate& aPredicate, const Point& aPoint,
+				     const Point aConvM2, const Point aConvM1, const Coordinate aQk)
   {
 
+    //the points of the search are aBase + q * aConvM1
+    const Point aBase = aPoint + aConvM2; 
+
     // orientation test
-    int plus0;
-    int plus1;
-    if (myPredicate.getArea(aPoint, aPoint + aConvM2, aPoint + aConvM2 + aConvM1) >= 0)
+    Coordinate plus0;
+    Coordinate plus1;
+    if (aPredicate.getArea(aPoint, aBase, aBase + aConvM1) >= 0)
       {
         plus0 = 0;
         plus1 = 1;
@@ -135,13 +180,13 @@ public:
         mid = (qkstart + qkstop)/2;
 
         // radius test
-        if ( myPredicate(aPoint, 
-			 (aPoint + aConvM2 + aConvM1*(mid+plus0)), 
-			 (aPoint + aConvM2 + aConvM1*(mid+plus1))) )
+        if ( aPredicate(aPoint, 
+			 aBase.plusScaled(aConvM1, mid+plus0), 
+			 aBase.plusScaled(aConvM1, mid+plus1)) )
 	  { //search in the upper range
-	    if ( !myPredicate(aPoint, 
-			      (aPoint + aConvM2 + aConvM1*(mid+2*plus0+plus1)), 
-			      (aPoint + aConvM2 + aConvM1*(mid+2*plus1+plus0))) )
+	    if ( !aPredicate(aPoint, 
+			      aBase.plusScaled(aConvM1, mid+2*plus0+plus1), 
+			      aBase.plusScaled(aConvM1, mid+2*plus1+plus0)) )
               {
                 return(mid+1);
               }
@@ -153,9 +198,9 @@ public:
 	  }
         else
 	  { //search in the lower range
-	    if(myPredicate(aPoint, 
-			   (aPoint + aConvM2 + aConvM1*(mid-2*plus0-plus1)), 
-			   (aPoint + aConvM2 + aConvM1*(mid-2*plus1-plus0))))
+	    if(aPredicate(aPoint, 
+			   aBase.plusScaled(aConvM1, mid-2*plus0-plus1), 
+			   aBase.plusScaled(aConvM1, mid-2*plus1-plus0)))
 	      {
 		return(mid-1);
 	      }
@@ -227,19 +272,17 @@ public:
             if (k > 0 && qk <= 0) 
 	      {
 		// pConvM1 translation
-		Point prevLastPoint = pConvM1;
-		Point lastPoint = prevLastPoint + vConvM1;
+		typename Shape::RayCursor cursor = myShape.cursor(pConvM1, vConvM1); 
 
-		while (myShape(lastPoint) >= 0)
+		while (cursor.nextValue() >= 0)
 		  {
 		    // Convex Hull case, we do not add the vertex
 		    if (!aAlphaInf)
-			    *res++ = prevLastPoint;
+			    *res++ = cursor.point();
 		      
-		    prevLastPoint = lastPoint; 
-		    lastPoint += vConvM1;
+		    cursor.advance(); 
 		  } 
-		return(prevLastPoint);
+		return(cursor.point());
 	      }
           }
 	else
@@ -322,19 +365,17 @@ public:
     // enable or disable the
     // retrieval of all such points  
     // with aAlphaInf 
-    Point prevLastPoint = pConvM1;
-    Point lastPoint = prevLastPoint + vConvM1; 
+    typename Shape::RayCursor cursor = myShape.cursor(pConvM1, vConvM1); 
 
-    while (myShape(lastPoint) >= 0)
+    while (cursor.nextValue() >= 0)
       {
 	// Convex Hull case, we do not add the vertex
 	if (!aAlphaInf)
-    *res++ = prevLastPoint;
+    *res++ = cursor.point();
   
-	prevLastPoint = lastPoint; 
-	lastPoint += vConvM1;
+	cursor.advance(); 
       } 
-    return(prevLastPoint);
+    return(cursor.point());
   }//end proc
 
 
@@ -357,6 +398,35 @@ public:
     if((*this).getPredicate().getDen2() == 0)
       alphainf = true;
 
+    DiscSymmetry<Shape> symmetry(myShape, aStartingPoint); 
+    if ( (myIsSymmetric) && (symmetry.getOrder() > 1) )
+      {
+	//vertices from the first vertex to the 
+	//end of the fundamental sector
+	std::vector<Point> arc; 
+	bool isInSector = false, isComplete = false; 
+	const Point first = symmetry.getFirstVertex(); 
+	tmp = first; 
+	do {
+	  std::vector<Point> vertices(1, tmp); 
+	  tmp = next(tmp, std::back_inserter(vertices), alphainf); 
+	  for (unsigned int i = 0; (i < vertices.size()) && (!isComplete); i++)
+	    {
+	      if (symmetry.isInSector(vertices[i]))
+		isInSector = true; 
+	      else if (isInSector)
+		isComplete = true; 
+	      if (!isComplete)
+		arc.push_back(vertices[i]); 
+	    }
+	} while ( (!isComplete) && (tmp != first) ); 
+	if (isComplete)
+	  symmetry.unfold(arc, aStartingPoint, res); 
+	else //all the vertices are retrieved
+	  symmetry.rotate(arc, aStartingPoint, res); 
+	return; 
+      }
+
     do 
       {
 	// stores the last retrieved vertex
@@ -379,6 +449,34 @@ public:
     all(myShape.getConvexHullVertex(), res); 
   }
 
+  /**
+   * Lazy range over the vertices of the alpha-shape
+   * in a counter-clockwise order from a given vertex: 
+   * the vertices lying between two consecutive vertices 
+   * of the convex hull are only computed when the iterator 
+   * reaches them (see VertexRange). 
+   *  
+   * @param aStartingPoint a vertex of the convex hull
+   * @return range of vertices
+   */
+  VertexRange<IncrementalNegativeAlphaShape> vertices(const Point& aStartingPoint)
+  {
+    // if the denominator == 0, the radius is infinite.
+    bool alphainf = (myPredicate.getDen2() == 0); 
+    return VertexRange<IncrementalNegativeAlphaShape>(*this, aStartingPoint, alphainf); 
+  }
+
+  /**
+   * Lazy range over the vertices of the alpha-shape
+   * in a counter-clockwise order
+   *  
+   * @return range of vertices
+   */
+  VertexRange<IncrementalNegativeAlphaShape> vertices()
+  {
+    return vertices(myShape.getConvexHullVertex()); 
+  }
+
 }; 
 #endif
 
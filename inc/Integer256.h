@@ -0,0 +1,385 @@
+#ifndef Integer256_h
+  #define Integer256_h
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+
+#include "IntegerHelpers.h"
+
+/**
+ * Class implementing a fixed-size signed integer of 256 bits,
+ * stored in two's complement as four 64-bit limbs.
+ * It provides the operations required by the ray intersectable
+ * shapes (arithmetic operations, comparisons, conversions),
+ * without any dynamic allocation.
+ * NB: arithmetic operations are performed modulo 2^256,
+ * overflows are not detected.
+ *
+ * Basic usage:
+ * @code
+ Integer256 a(1);
+ Integer256 b = (a + 2) * 5;
+ * @endcode
+ */
+class Integer256
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef unsigned long long Limb;
+  typedef unsigned __int128 DoubleLimb;
+
+private:
+  /////////////////////// members /////////////////////
+  /**
+   * Limbs, from the least significant to the most significant one
+   */
+  Limb myLimbs[4];
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Default constructor
+   */
+  Integer256() { set(0); }
+
+  /**
+   * Constructors from builtin integers
+   * @param x any integer
+   */
+  Integer256(const int& x) { set(x); }
+  Integer256(const long& x) { set(x); }
+  Integer256(const long long& x) { set(x); }
+  Integer256(const Int128& x) { set(x); }
+
+private:
+  /**
+   * Sets the limbs from a 128-bit integer
+   * @param x any integer
+   */
+  void set(const Int128& x)
+  {
+    myLimbs[0] = (Limb) x;
+    myLimbs[1] = (Limb) (x >> 64);
+    myLimbs[2] = myLimbs[3] = ( (x < 0)?~( (Limb) 0 ):0 );
+  }
+
+public:
+  ///////////////////// read access ///////////////////
+  /**
+   * @param i index in 0..3
+   * @return i-th limb
+   */
+  Limb limb(const int& i) const { return myLimbs[i]; }
+
+  /**
+   * @return 'true' if the integer is negative
+   */
+  bool isNegative() const { return ( (myLimbs[3] >> 63) != 0 ); }
+
+  /**
+   * @return -1, 0 or 1 according to the sign
+   */
+  int sign() const
+  {
+    if (isNegative()) return -1;
+    return ( (myLimbs[0] | myLimbs[1] | myLimbs[2] | myLimbs[3]) != 0 )?1:0;
+  }
+
+  /**
+   * @return number of bits of the absolute value (0 for 0)
+   */
+  int bitLength() const
+  {
+    Integer256 m = (isNegative())?( -(*this) ):( *this );
+    for (int i = 3; i >= 0; i--)
+      if (m.myLimbs[i] != 0)
+	return 64*i + 64 - __builtin_clzll(m.myLimbs[i]);
+    return 0;
+  }
+
+  /**
+   * @param aNbLimbs number of least significant limbs
+   * @return 'true' if the integer is representable
+   * with @a aNbLimbs limbs in two's complement
+   */
+  bool fits(const int& aNbLimbs) const
+  {
+    Limb ext = ( (myLimbs[aNbLimbs-1] >> 63) != 0 )?~( (Limb) 0 ):0;
+    for (int i = aNbLimbs; i < 4; i++)
+      if (myLimbs[i] != ext) return false;
+    return true;
+  }
+
+  ///////////////////// arithmetic ///////////////////
+  Integer256 operator-() const
+  {
+    Integer256 res;
+    Limb carry = 1;
+    for (int i = 0; i < 4; i++)
+      {
+	res.myLimbs[i] = ~myLimbs[i] + carry;
+	carry = ( (carry == 1) && (res.myLimbs[i] == 0) )?1:0;
+      }
+    return res;
+  }
+
+  Integer256& operator+=(const Integer256& y)
+  {
+    Limb carry = 0;
+    for (int i = 0; i < 4; i++)
+      {
+	DoubleLimb s = (DoubleLimb) myLimbs[i] + y.myLimbs[i] + carry;
+	myLimbs[i] = (Limb) s;
+	carry = (Limb) (s >> 64);
+      }
+    return *this;
+  }
+
+  Integer256& operator-=(const Integer256& y)
+  {
+    return ( *this += (-y) );
+  }
+
+  Integer256& operator*=(const Integer256& y)
+  {
+    Limb res[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++)
+      {
+	Limb carry = 0;
+	for (int j = 0; i + j < 4; j++)
+	  {
+	    DoubleLimb p = (DoubleLimb) myLimbs[i] * y.myLimbs[j] + res[i+j] + carry;
+	    res[i+j] = (Limb) p;
+	    carry = (Limb) (p >> 64);
+	  }
+      }
+    std::copy(res, res+4, myLimbs);
+    return *this;
+  }
+
+  /**
+   * Division, truncated toward zero as for builtin integers.
+   * The cost is linear in the number of bits of the quotient.
+   * @param y non-zero divisor
+   */
+  Integer256& operator/=(const Integer256& y)
+  {
+    if ( fits(2) && y.fits(2) )
+      { //128-bit division, except -2^127 / -1 
+	//whose quotient does not fit in 128 bits
+	Int128 d = y.toInt128();
+	*this = (d == -1)?( -(*this) ):( Integer256( toInt128() / d ) );
+	return *this;
+      }
+    bool negative = (isNegative() != y.isNegative());
+    Integer256 r = (isNegative())?( -(*this) ):( *this );
+    Integer256 d = (y.isNegative())?( -y ):( y );
+    Integer256 q(0);
+    int shift = r.bitLength() - d.bitLength();
+    if (shift >= 0)
+      {
+	d = d << shift;
+	for (int i = shift; i >= 0; i--)
+	  {
+	    q = q << 1;
+	    if ( r.compare(d) >= 0 )
+	      {
+		r -= d;
+		q += Integer256(1);
+	      }
+	    d = d >> 1;
+	  }
+      }
+    *this = (negative)?( -q ):( q );
+    return *this;
+  }
+
+  /**
+   * Remainder, with the sign of the dividend
+   * as for builtin integers.
+   * @param y non-zero divisor
+   */
+  Integer256& operator%=(const Integer256& y)
+  {
+    Integer256 q(*this);
+    q /= y;
+    q *= y;
+    return ( *this -= q );
+  }
+
+  /**
+   * Logical shifts on the two's complement representation
+   * @param n number of bits in 0..255
+   */
+  Integer256 operator<<(const int& n) const
+  {
+    Integer256 res(0);
+    int l = n / 64, b = n % 64;
+    for (int i = 3; i >= l; i--)
+      {
+	res.myLimbs[i] = myLimbs[i-l] << b;
+	if ( (b != 0) && (i-l-1 >= 0) )
+	  res.myLimbs[i] |= myLimbs[i-l-1] >> (64-b);
+      }
+    return res;
+  }
+  Integer256 operator>>(const int& n) const
+  {
+    Integer256 res(0);
+    int l = n / 64, b = n % 64;
+    for (int i = 0; i + l < 4; i++)
+      {
+	res.myLimbs[i] = myLimbs[i+l] >> b;
+	if ( (b != 0) && (i+l+1 < 4) )
+	  res.myLimbs[i] |= myLimbs[i+l+1] << (64-b);
+      }
+    return res;
+  }
+
+  ///////////////////// comparisons ///////////////////
+  /**
+   * @param y other integer
+   * @return -1, 0 or 1 if *this is lower than,
+   * equal to or greater than @a y
+   */
+  int compare(const Integer256& y) const
+  {
+    if (isNegative() != y.isNegative())
+      return (isNegative())?-1:1;
+    for (int i = 3; i >= 0; i--)
+      if (myLimbs[i] != y.myLimbs[i])
+	return (myLimbs[i] < y.myLimbs[i])?-1:1;
+    return 0;
+  }
+
+  ///////////////////// conversions ///////////////////
+  /**
+   * @return the least significant 64 bits as a signed integer
+   */
+  long long toInt64() const { return (long long) myLimbs[0]; }
+
+  /**
+   * @return the least significant 128 bits as a signed integer
+   */
+  Int128 toInt128() const
+  { return (Int128) ( ( (DoubleLimb) myLimbs[1] << 64 ) | myLimbs[0] ); }
+
+  /**
+   * @return (rounded) value as a double
+   */
+  double toDouble() const
+  {
+    Integer256 m = (isNegative())?( -(*this) ):( *this );
+    double res = 0;
+    for (int i = 3; i >= 0; i--)
+      res = res * 18446744073709551616.0 + (double) m.myLimbs[i];
+    return (isNegative())?( -res ):( res );
+  }
+};
+
+inline Integer256 operator+(Integer256 x, const Integer256& y) { return x += y; }
+inline Integer256 operator-(Integer256 x, const Integer256& y) { return x -= y; }
+inline Integer256 operator*(Integer256 x, const Integer256& y) { return x *= y; }
+inline Integer256 operator/(Integer256 x, const Integer256& y) { return x /= y; }
+inline Integer256 operator%(Integer256 x, const Integer256& y) { return x %= y; }
+
+inline bool operator==(const Integer256& x, const Integer256& y) { return x.compare(y) == 0; }
+inline bool operator!=(const Integer256& x, const Integer256& y) { return x.compare(y) != 0; }
+inline bool operator<(const Integer256& x, const Integer256& y) { return x.compare(y) < 0; }
+inline bool operator>(const Integer256& x, const Integer256& y) { return x.compare(y) > 0; }
+inline bool operator<=(const Integer256& x, const Integer256& y) { return x.compare(y) <= 0; }
+inline bool operator>=(const Integer256& x, const Integer256& y) { return x.compare(y) >= 0; }
+
+/**
+ * Display an integer in decimal notation
+ * @param out output stream
+ * @param x integer to display
+ * @return output stream
+ */
+inline std::ostream& operator<<(std::ostream& out, const Integer256& x)
+{
+  Integer256 m = (x.isNegative())?( -x ):( x );
+  std::string digits;
+  do
+    {
+      Integer256 q = m / Integer256(10);
+      digits += (char) ( '0' + (m - q * Integer256(10)).toInt64() );
+      m = q;
+    }
+  while (m.sign() != 0);
+  if (x.isNegative()) digits += '-';
+  std::reverse(digits.begin(), digits.end());
+  out << digits;
+  return out;
+}
+
+/**
+ * Specialization for 256-bit integers.
+ * NB: the overflow checks are conservative,
+ * ie. they may report an overflow that does not occur.
+ */
+template <>
+struct IntegerTraits<Integer256>
+{
+  typedef Integer256 T;
+
+  static bool isInt64(const T& x)
+  { return x.fits(1); }
+
+  static long long castToInt64(const T& x)
+  { return x.toInt64(); }
+
+  static bool isInt128(const T& x)
+  { return x.fits(2); }
+
+  static Int128 castToInt128(const T& x)
+  { return x.toInt128(); }
+
+  static T castFromInt64(const long long& x)
+  { return T(x); }
+
+  static T castFromInt128(const Int128& x)
+  { return T(x); }
+
+  static double castToDouble(const T& x)
+  { return x.toDouble(); }
+
+  static int bitLength(const T& x)
+  { return x.bitLength(); }
+
+  static bool add(const T& x, const T& y, T& r)
+  {
+    r = x + y;
+    return ( (x.isNegative() != y.isNegative()) || (r.isNegative() == x.isNegative()) );
+  }
+
+  static bool sub(const T& x, const T& y, T& r)
+  {
+    r = x - y;
+    return ( (x.isNegative() == y.isNegative()) || (r.isNegative() == x.isNegative()) );
+  }
+
+  static bool mul(const T& x, const T& y, T& r)
+  {
+    r = x * y;
+    return ( x.bitLength() + y.bitLength() < 256 );
+  }
+
+  static T isqrt(const T& x)
+  {
+    if (x.fits(2))
+      return T( IntegerTraits<Int128>::isqrt( x.toInt128() ) ); 
+    //Newton iterations from a power of two greater than the result
+    T r = T(1) << ( (x.bitLength() + 1) / 2 ); 
+    T s = (r + x/r) >> 1; 
+    while (s < r)
+      {
+	r = s; 
+	s = (r + x/r) >> 1; 
+      }
+    return r; 
+  }
+};
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef IntegerHelpers_h
+  #define IntegerHelpers_h
+
+#include <cmath>
+
+#include <DGtal/base/Common.h>
+
+/**
+ * 128-bit signed integer (gcc/clang extension),
+ * used as an intermediate precision between
+ * machine words and DGtal::BigInteger.
+ */
+typedef __int128 Int128;
+
+/**
+ * Class gathering the services that are required
+ * to move an integer between the different precisions
+ * (machine word, 128-bit integer, arbitrary precision)
+ * and to detect overflows.
+ *
+ * Basic usage:
+ * @code
+ long long r;
+ if ( IntegerTraits<long long>::mul(a, b, r) )
+   //r is equal to a*b
+ else
+   //a*b does not fit in a machine word
+ * @endcode
+ *
+ * @tparam T a model of builtin integer
+ * (a specialization is provided for DGtal::BigInteger)
+ */
+template <typename T>
+struct IntegerTraits
+{
+  /**
+   * @param x any integer
+   * @return 'true' if @a x fits in a signed 64-bit integer
+   */
+  static bool isInt64(const T& x)
+  { return ( (T) (long long) x == x ); }
+
+  /**
+   * @param x any integer fitting in a signed 64-bit integer
+   * @return @a x as a signed 64-bit integer
+   */
+  static long long castToInt64(const T& x)
+  { return (long long) x; }
+
+  /**
+   * @param x any integer
+   * @return 'true' if @a x fits in a signed 128-bit integer
+   */
+  static bool isInt128(const T& x)
+  { return ( (T) (Int128) x == x ); }
+
+  /**
+   * @param x any integer fitting in a signed 128-bit integer
+   * @return @a x as a signed 128-bit integer
+   */
+  static Int128 castToInt128(const T& x)
+  { return (Int128) x; }
+
+  /**
+   * @param x any signed 64-bit integer
+   * @return @a x as an integer of type T
+   */
+  static T castFromInt64(const long long& x)
+  { return (T) x; }
+
+  /**
+   * @param x any signed 128-bit integer
+   * @return @a x as an integer of type T
+   */
+  static T castFromInt128(const Int128& x)
+  { return (T) x; }
+
+  /**
+   * @param x any integer
+   * @return (rounded) value of @a x as a double
+   */
+  static double castToDouble(const T& x)
+  { return (double) x; }
+
+  /**
+   * @param x any integer
+   * @return number of bits of the absolute value of @a x
+   * (0 if @a x is equal to 0)
+   */
+  static int bitLength(const T& x)
+  {
+    unsigned __int128 u = (x < 0)?( - (unsigned __int128) (Int128) x ):( (unsigned __int128) (Int128) x );
+    int n = 0;
+    if ( (u >> 64) != 0 ) { n = 64; u >>= 64; }
+    unsigned long long l = (unsigned long long) u;
+    return ( (l == 0)?n:(n + 64 - __builtin_clzll(l)) );
+  }
+
+  /**
+   * Overflow-checked addition
+   * @param x first operand
+   * @param y second operand
+   * @param r (returned) sum @a x + @a y
+   * @return 'false' if the sum overflows, 'true' otherwise
+   */
+  static bool add(const T& x, const T& y, T& r)
+  { return !__builtin_add_overflow(x, y, &r); }
+
+  /**
+   * Overflow-checked substraction
+   * @param x first operand
+   * @param y second operand
+   * @param r (returned) difference @a x - @a y
+   * @return 'false' if the difference overflows, 'true' otherwise
+   */
+  static bool sub(const T& x, const T& y, T& r)
+  { return !__builtin_sub_overflow(x, y, &r); }
+
+  /**
+   * Overflow-checked multiplication
+   * @param x first operand
+   * @param y second operand
+   * @param r (returned) product @a x * @a y
+   * @return 'false' if the product overflows, 'true' otherwise
+   */
+  static bool mul(const T& x, const T& y, T& r)
+  { return !__builtin_mul_overflow(x, y, &r); }
+
+  /**
+   * Integer square root: a double approximation
+   * is refined by Newton iterations from above. 
+   * @param x any non-negative integer
+   * @return floor of the square root of @a x
+   */
+  static T isqrt(const T& x)
+  {
+    if (x < 2) return x; 
+    T r = (T) std::sqrt( (double) x ); 
+    if (r == 0) r = 1; 
+    //upper bound of the result
+    r = (r + x/r) / 2; 
+    T s = (r + x/r) / 2; 
+    while (s < r)
+      {
+	r = s; 
+	s = (r + x/r) / 2; 
+      }
+    return r; 
+  }
+};
+
+/**
+ * Specialization for arbitrary precision integers,
+ * whose arithmetic operations never overflow.
+ * NB: DGtal::BigInteger is assumed to be a gmp mpz_class
+ * and long to be a 64-bit integer.
+ */
+template <>
+struct IntegerTraits<DGtal::BigInteger>
+{
+  typedef DGtal::BigInteger T;
+
+  static bool isInt64(const T& x)
+  { return ( mpz_sizeinbase(x.get_mpz_t(), 2) < 64 ); }
+
+  static long long castToInt64(const T& x)
+  { return (long long) x.get_si(); }
+
+  static bool isInt128(const T& x)
+  { return ( mpz_sizeinbase(x.get_mpz_t(), 2) < 128 ); }
+
+  static Int128 castToInt128(const T& x)
+  {
+    T ax = abs(x);
+    T hi = ax >> 64;
+    //least significant 64 bits of |x|
+    unsigned __int128 u = mpz_get_ui(ax.get_mpz_t());
+    u += ( (unsigned __int128) mpz_get_ui(hi.get_mpz_t()) ) << 64;
+    return ( (sgn(x) < 0)?( - (Int128) u ):( (Int128) u ) );
+  }
+
+  static T castFromInt64(const long long& x)
+  { return T( (long) x ); }
+
+  static T castFromInt128(const Int128& x)
+  {
+    unsigned __int128 u = (x < 0)?( - (unsigned __int128) x ):( (unsigned __int128) x );
+    T r( (unsigned long) (u >> 64) );
+    r <<= 64;
+    r += (unsigned long) u;
+    return ( (x < 0)?T(-r):r );
+  }
+
+  static double castToDouble(const T& x)
+  { return x.get_d(); }
+
+  static int bitLength(const T& x)
+  { return ( (x == 0)?0:(int) mpz_sizeinbase(x.get_mpz_t(), 2) ); }
+
+  static bool add(const T& x, const T& y, T& r)
+  { r = x + y; return true; }
+
+  static bool sub(const T& x, const T& y, T& r)
+  { r = x - y; return true; }
+
+  static bool mul(const T& x, const T& y, T& r)
+  { r = x * y; return true; }
+
+  static T isqrt(const T& x)
+  { return sqrt(x); }
+};
+
+/**
+ * Floor of the quotient of two integers, 
+ * whereas builtin integer division truncates toward zero. 
+ * @param x dividend
+ * @param y positive divisor
+ * @return floor of @a x / @a y
+ *
+ * @tparam T a model of integer
+ */
+template <typename T>
+T floorDivision(const T& x, const T& y)
+{
+  T q = x / y; 
+  if ( (x < 0) && (q*y != x) )
+    q = q - 1; 
+  return q; 
+}
+
+/**
+ * Greatest common divisor (Euclid's algorithm)
+ * @param x any integer
+ * @param y any integer
+ * @return non-negative gcd of @a x and @a y 
+ * (0 if both are equal to 0)
+ *
+ * @tparam T a model of integer
+ */
+template <typename T>
+T greatestCommonDivisor(const T& x, const T& y)
+{
+  T u = (x < 0)?T(-x):x; 
+  T v = (y < 0)?T(-y):y; 
+  while (v != 0)
+    {
+      T r = u % v; 
+      u = v; 
+      v = r; 
+    }
+  return u; 
+}
+
+/**
+ * Extended Euclid's algorithm, which computes 
+ * Bezout coefficients together with the gcd
+ * @param x any integer
+ * @param y any integer
+ * @param aS (returned) coefficient of @a x
+ * @param aT (returned) coefficient of @a y
+ * @return non-negative gcd g of @a x and @a y, 
+ * such that @a aS * @a x + @a aT * @a y = g
+ *
+ * @tparam T a model of integer
+ */
+template <typename T>
+T extendedGreatestCommonDivisor(const T& x, const T& y, T& aS, T& aT)
+{
+  //invariants: u = s0 x + t0 y, v = s1 x + t1 y
+  T u = x, v = y; 
+  T s0 = 1, t0 = 0, s1 = 0, t1 = 1; 
+  while (v != 0)
+    {
+      T q = u / v; 
+      T r = u - q*v; 
+      u = v; 
+      v = r; 
+      r = s0 - q*s1; 
+      s0 = s1; 
+      s1 = r; 
+      r = t0 - q*t1; 
+      t0 = t1; 
+      t1 = r; 
+    }
+  if (u < 0)
+    {
+      u = -u; 
+      s0 = -s0; 
+      t0 = -t0; 
+    }
+  aS = s0; 
+  aT = t0; 
+  return u; 
+}
+
+#endif
@@ -0,0 +1,428 @@
+#ifndef KineticCircleConvexHull_h
+#define KineticCircleConvexHull_h
+
+#include<map>
+#include<set>
+#include<vector>
+#include<iterator>
+
+#include "BasicHelpers.h"
+#include "IntegerHelpers.h"
+#include "OutputSensitiveConvexHull.h"
+
+/**
+ * Class implementing a kinetic structure that maintains the
+ * vertices of the convex hull of all digital points lying
+ * inside a circle, while the d-parameter of the circle increases,
+ * ie. while the disc grows around the same center.
+ *
+ * Since the disc grows, the digital points that lie inside it
+ * remain inside it and an edge of the convex hull remains an
+ * edge as long as no digital point lying beyond it, or just
+ * before its first vertex or just after its last vertex
+ * along its line, enters the disc. Each edge is thus
+ * certified by the smallest value of the d-parameter for which
+ * one of these points lies inside the circle (see certificate).
+ * When the d-parameter is updated, only the edges whose
+ * certificate fails are removed and the chains of vertices
+ * between the remaining edges are retrieved again by ray casting
+ * (see OutputSensitiveConvexHull::next), so that the cost of
+ * a sweep depends on the number of vertices that change rather
+ * than on the number of vertices of each convex hull.
+ *
+ * The structure also follows a disc of fixed radius whose center
+ * moves, ie. whose a-, b- and d-parameters change (see setParameters).
+ * Since the digital points may leave the disc, the certificates are
+ * recomputed for the new circle: an edge is kept if its vertices
+ * still lie inside the disc and its certificate does not fail,
+ * which costs a few arithmetic operations per edge, and only
+ * the chains of vertices between the kept edges are retrieved
+ * again by ray casting.
+ *
+ * Basic usage:
+ * @code
+ KineticCircleConvexHull<Circle> kch( Circle(a, b, c, d) );
+ for (Integer e = d; e < dmax; e++)
+   {
+     kch.setD(e);
+     std::vector<Point> v;
+     kch.all( std::back_inserter(v) );
+   }
+ * @endcode
+ *
+ * NB: the circle must contain at least two digital points,
+ * as for OutputSensitiveConvexHull.
+ *
+ * @tparam TCircle a model of circle with parameters a, b, c, d
+ * given in a local frame and c < 0 (see ExactRayIntersectableCircle).
+ * @tparam TInteger a model of integer used for the orientation
+ * tests (see OutputSensitiveConvexHull).
+ */
+template <typename TCircle, typename TInteger = Int128>
+class KineticCircleConvexHull
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TCircle Circle;
+  typedef typename Circle::Point Point;
+  typedef typename Point::Coordinate Coordinate;
+  typedef typename Circle::Integer Parameter;
+  typedef TInteger Integer;
+  typedef OutputSensitiveConvexHull<Circle, Integer> ConvexHull;
+
+private:
+  /**
+   * Lexicographic order on points
+   */
+  struct PointLess
+  {
+    bool operator()(const Point& p, const Point& q) const
+    {
+      return ( (p[0] < q[0]) || ( (p[0] == q[0]) && (p[1] < q[1]) ) );
+    }
+  };
+
+  /**
+   * Certificates of the edges, ie. the first vertex of each edge
+   * sorted by the value of the d-parameter for which it fails
+   */
+  typedef std::multimap<Parameter, Point> Certificates;
+
+  /**
+   * Edge starting at a vertex: its last vertex and its certificate
+   */
+  struct Edge
+  {
+    Point last;
+    typename Certificates::iterator certificate;
+  };
+
+  /////////////////////// members /////////////////////
+  /**
+   * Current circle
+   */
+  Circle myCircle;
+
+  /**
+   * Edges of the convex hull, in a counter-clockwise order,
+   * from their first vertex, and previous vertex of each vertex
+   */
+  std::map<Point, Edge, PointLess> myEdges;
+  std::map<Point, Point, PointLess> myPrevious;
+
+  /**
+   * Certificates of the edges
+   */
+  Certificates myCertificates;
+
+  /**
+   * Number of vertices retrieved by ray casting
+   */
+  unsigned long long myNbRetrievedVertices;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Standard constructor, which retrieves all the vertices
+   * of the convex hull of the digital points lying inside
+   * @a aCircle
+   * @param aCircle a circle
+   */
+  KineticCircleConvexHull(const Circle& aCircle)
+    : myCircle(aCircle), myNbRetrievedVertices(0)
+  {
+    ASSERT( (aCircle.c() < 0) && "Error in KineticCircleConvexHull: c must be negative" );
+    init();
+  }
+
+private:
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  KineticCircleConvexHull(const KineticCircleConvexHull& other) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  KineticCircleConvexHull& operator=(const KineticCircleConvexHull& other)
+  { return *this; }
+
+public:
+  /**
+   * Default destructor
+   */
+  ~KineticCircleConvexHull() {}
+
+  /**
+   * @return current circle
+   */
+  const Circle& getCircle() const { return myCircle; }
+
+  /**
+   * @return number of vertices of the convex hull
+   */
+  std::size_t size() const { return myEdges.size(); }
+
+  /**
+   * @return number of vertices retrieved by ray casting
+   * since the construction
+   */
+  unsigned long long getNbRetrievedVertices() const { return myNbRetrievedVertices; }
+
+private:
+  /**
+   * Conversion of a coordinate into the parameter type
+   * (see ExactRayIntersectableCircle::toInteger)
+   * @param x any coordinate
+   * @return @a x as an integer of type Parameter
+   */
+  static Parameter toParameter(const Coordinate& x)
+  {
+    return IntegerTraits<Parameter>::castFromInt64( IntegerTraits<Coordinate>::castToInt64(x) );
+  }
+
+  /**
+   * @param aPoint any point
+   * @return smallest value of the d-parameter for which
+   * @a aPoint lies inside the circle, ie. -(ax + by + c(x^2 + y^2))
+   * in the local frame of the circle
+   */
+  Parameter entering(const Point& aPoint) const
+  {
+    Parameter x = toParameter(aPoint[0] - myCircle.getShift()[0]);
+    Parameter y = toParameter(aPoint[1] - myCircle.getShift()[1]);
+    return -( myCircle.a()*x + myCircle.b()*y + myCircle.c()*(x*x + y*y) );
+  }
+
+  /**
+   * Computes the certificate of an edge, ie. the smallest value
+   * of the d-parameter for which a digital point lying beyond the
+   * edge, or the point just before @a aFirst or just after @a aLast
+   * along the edge, lies inside the circle.
+   *
+   * Let u be the primitive direction of the edge, n its outward
+   * normal and w such that <n,w> = 1. Along the line of level j,
+   * ie. the points p + jw + tu, the value of the d-parameter for
+   * which a point enters is a convex quadratic polynomial in t,
+   * whose minimum over the integers is one of the two integers
+   * around its real minimum. The lines are scanned from the
+   * level 1 until their real minimum exceeds the best value,
+   * which ends since the center lies behind them.
+   * If the center does not lie behind the line of level 1,
+   * the current d-parameter is returned, so that the edge is
+   * checked at the next update.
+   *
+   * @param aFirst first vertex of the edge
+   * @param aLast last vertex of the edge
+   * @return certificate of the edge
+   */
+  Parameter certificate(const Point& aFirst, const Point& aLast) const
+  {
+    Point u = aLast - aFirst;
+    Coordinate g = greatestCommonDivisor(u[0], u[1]);
+    u = Point(u[0]/g, u[1]/g);
+    Parameter res = std::min( entering(aFirst - u), entering(aLast + u) );
+
+    //w such that <n,w> = u1 w0 - u0 w1 = 1
+    Coordinate s, t;
+    extendedGreatestCommonDivisor(u[1], Coordinate(-u[0]), s, t);
+    Point w(s, t);
+
+    Parameter a = myCircle.a(), b = myCircle.b(), c = myCircle.c();
+    Parameter u0 = toParameter(u[0]), u1 = toParameter(u[1]);
+    //center behind the line of level 1,
+    //ie. 2c(<n,p> + 1) + <n,(a,b)> < 0
+    Point p = aFirst - myCircle.getShift() + w;
+    Parameter level = u1*toParameter(p[0]) - u0*toParameter(p[1]);
+    if ( (2*c*level + u1*a - u0*b) >= 0 )
+      return myCircle.d();
+
+    Parameter alpha = -c*(u0*u0 + u1*u1);
+    for (Point x = aFirst + w; true; x += w)
+      {
+	Point y = x - myCircle.getShift();
+	Parameter xu = toParameter(y[0])*u0 + toParameter(y[1])*u1;
+	Parameter beta = -(a*u0 + b*u1 + 2*c*xu);
+	Parameter gamma = entering(x);
+	if ( (4*alpha*gamma - beta*beta) >= (4*alpha*res) )
+	  return res;
+	Parameter k = floorDivision( Parameter(-beta), Parameter(2*alpha) );
+	res = std::min( res, Parameter( (alpha*k + beta)*k + gamma ) );
+	res = std::min( res, Parameter( (alpha*(k+1) + beta)*(k+1) + gamma ) );
+      }
+  }
+
+  /**
+   * Adds an edge and its certificate
+   * @param aFirst first vertex of the edge
+   * @param aLast last vertex of the edge
+   */
+  void link(const Point& aFirst, const Point& aLast)
+  {
+    Edge e;
+    e.last = aLast;
+    e.certificate = myCertificates.insert( std::make_pair(certificate(aFirst, aLast), aFirst) );
+    myEdges[aFirst] = e;
+    myPrevious[aLast] = aFirst;
+  }
+
+  /**
+   * Retrieves all the vertices of the convex hull
+   * and computes the certificates of its edges
+   */
+  void init()
+  {
+    myEdges.clear();
+    myPrevious.clear();
+    myCertificates.clear();
+    std::vector<Point> v;
+    ConvexHull ch(myCircle);
+    ch.all( std::back_inserter(v) );
+    myNbRetrievedVertices += v.size();
+    for (std::size_t i = 0; i < v.size(); i++)
+      link( v[i], v[(i+1)%v.size()] );
+  }
+
+  /**
+   * Removes the edges that fail, whose certificates are already
+   * removed, and retrieves the vertices between the remaining
+   * edges: the last vertex of an edge that does not fail is still
+   * a vertex, from which the vertices are retrieved by ray casting
+   * until the first vertex of the next edge that does not fail.
+   * All the edges that fail are removed before any new vertex is
+   * retrieved, so that a new chain may go through a former vertex
+   * of another chain. If all edges fail, the convex hull is
+   * retrieved from scratch.
+   * @param aFailures first vertices of the edges that fail
+   */
+  void repair(std::set<Point, PointLess>& aFailures)
+  {
+    if (aFailures.size() == myEdges.size())
+      {
+	init();
+	return;
+      }
+
+    //chains of edges that fail, from their first to their last vertex
+    std::vector<std::pair<Point, Point> > chains;
+    while (!aFailures.empty())
+      {
+	Point first = *aFailures.begin();
+	while (aFailures.count(myPrevious[first]) > 0)
+	  first = myPrevious[first];
+	Point last = first;
+	while (aFailures.count(last) > 0)
+	  {
+	    aFailures.erase(last);
+	    Point tmp = myEdges[last].last;
+	    myEdges.erase(last);
+	    if (last != first)
+	      myPrevious.erase(last);
+	    last = tmp;
+	  }
+	chains.push_back( std::make_pair(first, last) );
+      }
+
+    //new chains
+    ConvexHull ch(myCircle);
+    for (std::size_t i = 0; i < chains.size(); i++)
+      {
+	Point tmp = chains[i].first;
+	do {
+	  Point next = ch.next(tmp);
+	  link(tmp, next);
+	  tmp = next;
+	  myNbRetrievedVertices++;
+	} while (tmp != chains[i].second);
+      }
+  }
+
+public:
+  ///////////////////// main methods ///////////////////
+  /**
+   * Updates the d-parameter of the circle. If it increases, the
+   * edges whose certificate fails are removed and each chain of
+   * vertices between the remaining edges is retrieved again from
+   * its first vertex, which is still a vertex. Otherwise, the
+   * convex hull is retrieved from scratch.
+   * @param aD new d-parameter
+   */
+  void setD(const Parameter& aD)
+  {
+    bool isGrowing = (aD >= myCircle.d());
+    myCircle = Circle(myCircle.a(), myCircle.b(), myCircle.c(), aD, myCircle.getShift());
+    if (!isGrowing)
+      {
+	init();
+	return;
+      }
+
+    //first vertices of the edges that fail
+    std::set<Point, PointLess> failures;
+    while ( (!myCertificates.empty()) && (myCertificates.begin()->first <= aD) )
+      {
+	failures.insert(myCertificates.begin()->second);
+	myCertificates.erase(myCertificates.begin());
+      }
+    repair(failures);
+  }
+
+  /**
+   * Updates the a-, b- and d-parameters of the circle, eg. to
+   * translate the disc with a fixed radius (by a sub-pixel step if
+   * the a- and b-parameters change by less than 2|c|). Each edge is
+   * validated against the new circle, without any ray casting:
+   * its vertices must lie inside the circle and its certificate
+   * must not fail. The edges that are not valid are removed and
+   * each chain of vertices between the remaining edges is
+   * retrieved again from its first vertex.
+   * @param aA new a-parameter
+   * @param aB new b-parameter
+   * @param aD new d-parameter
+   */
+  void setParameters(const Parameter& aA, const Parameter& aB, const Parameter& aD)
+  {
+    myCircle = Circle(aA, aB, myCircle.c(), aD, myCircle.getShift());
+    const Parameter& d = myCircle.d();
+
+    //first vertices of the edges that fail
+    std::set<Point, PointLess> failures;
+    myCertificates.clear();
+    for (typename std::map<Point, Edge, PointLess>::iterator it = myEdges.begin();
+	 it != myEdges.end(); ++it)
+      {
+	const Point& first = it->first;
+	const Point& last = it->second.last;
+	Parameter t = certificate(first, last);
+	if ( (entering(first) <= d) && (entering(last) <= d) && (t > d) )
+	  it->second.certificate = myCertificates.insert( std::make_pair(t, first) );
+	else
+	  failures.insert(first);
+      }
+    repair(failures);
+  }
+
+  /**
+   * Retrieves all the vertices of the convex hull
+   * in a counter-clockwise order, from the vertex
+   * of minimal y-coordinate (and maximal x-coordinate
+   * among them), like OutputSensitiveConvexHull::all
+   *
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void all(OutputIterator res) const
+  {
+    const Point first = myCircle.getConvexHullVertex();
+    Point tmp = first;
+    do {
+      *res++ = tmp;
+      tmp = myEdges.find(tmp)->second.last;
+    } while (tmp != first);
+  }
+
+};
+#endif
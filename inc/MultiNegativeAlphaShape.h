@@ -0,0 +1,359 @@
+#ifndef MultiNegativeAlphaShape_h
+#define MultiNegativeAlphaShape_h
+
+#include<vector>
+#include<iterator>
+#include<algorithm>
+
+#include "BasicHelpers.h"
+#include "DiscSymmetry.h"
+#include "IncrementalNegativeAlphaShape.h"
+
+/**
+ * Class implementing an on-line and output-sensitive algorithm
+ * that retrieves the vertices of the alpha-shapes of all digital
+ * points lying inside a ray-intersectable shape, for a whole list
+ * of negative alphas at once (see IncrementalNegativeAlphaShape).
+ *
+ * The alpha-shapes whose current vertex is the same share the
+ * convergent loop of the method next, ie. the ray castings: at
+ * each convergent, the predicates of all the alphas are evaluated
+ * and the dichotomic search is run for each alpha whose alpha-shape
+ * has a vertex there, while the other ones go on along the loop.
+ * Since the radii are sorted, the alphas whose alpha-shape has a
+ * vertex at a convergent found above the shape are the first ones,
+ * which are found by a dichotomic search on the list. The
+ * alpha-shapes that are behind the other ones are moved forward
+ * first, so that they share again the loop from the next vertex
+ * of the convex hull.
+ *
+ * Basic usage:
+ * @code
+ std::vector<Predicate> predicates; //increasing radii, negative alphas
+ ...
+ MultiNegativeAlphaShape<Shape, Predicate> as(shape, predicates);
+ std::vector<std::vector<Point> > v( predicates.size() );
+ std::vector<std::back_insert_iterator<std::vector<Point> > > res;
+ for (unsigned int i = 0; i < v.size(); i++)
+   res.push_back( std::back_inserter(v[i]) );
+ as.all(res);
+ * @endcode
+ *
+ * @tparam TShape a model of ray-intersectable shape.
+ * @tparam TPredicate a model of ternary predicate with a
+ * radius, like CircumcircleRadiusPredicate with a negative sign.
+ */
+template <typename TShape, typename TPredicate>
+class MultiNegativeAlphaShape
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TShape Shape;
+  typedef typename Shape::Point Point;
+  typedef typename Shape::Vector Vector;
+  typedef TPredicate Predicate;
+  typedef typename Point::Coordinate Coordinate;
+  typedef IncrementalNegativeAlphaShape<Shape, Predicate> AlphaShape;
+
+private:
+  /////////////////////// members /////////////////////
+  /**
+   * const reference on a shape
+   */
+  const Shape& myShape;
+
+  /**
+   * const reference on the predicates, sorted by increasing
+   * radius (the last ones may have an infinite radius)
+   */
+  const std::vector<Predicate>& myPredicates;
+
+  /**
+   * 'true' if the symmetries of the shape are used
+   * by the method all (see setSymmetry)
+   */
+  bool myIsSymmetric;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Standard constructor
+   * @param aShape any 'ray-intersectable' shape
+   * @param aPredicates predicates of negative sign,
+   * sorted by increasing radius
+   */
+  MultiNegativeAlphaShape(const Shape& aShape, const std::vector<Predicate>& aPredicates)
+    : myShape(aShape), myPredicates(aPredicates), myIsSymmetric(true)
+  {
+    for (std::size_t i = 1; i < aPredicates.size(); i++)
+      ASSERT( (aPredicates[i-1].getNum2()*aPredicates[i].getDen2()
+	       <= aPredicates[i].getNum2()*aPredicates[i-1].getDen2())
+	      && "Error in MultiNegativeAlphaShape: the radii are not sorted" );
+  }
+
+private:
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  MultiNegativeAlphaShape(const MultiNegativeAlphaShape& other) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  MultiNegativeAlphaShape& operator=(const MultiNegativeAlphaShape& other)
+  { return *this; }
+
+public:
+  /**
+   * Default destructor
+   */
+  ~MultiNegativeAlphaShape() {}
+
+  /**
+   * Enables or disables the use of the symmetries
+   * of the shape by the method all (enabled by default)
+   * @param aFlag 'true' to enable the use of the symmetries
+   */
+  void setSymmetry(bool aFlag) { myIsSymmetric = aFlag; }
+
+private:
+  /**
+   * Stores the points lying on the last edge, from a convergent
+   * inside the shape, for the alphas that are not infinite, and
+   * the point following them as the last vertex of all alphas.
+   * @param aPoint last convergent inside the shape
+   * @param aDir direction of the edge
+   * @param aGroup indices of the predicates
+   * @param aFirst position in @a aGroup of the first alpha
+   * @param aVertices (returned) vertices of each alpha of @a aGroup
+   * @param aNext (returned) last vertex of each alpha of @a aGroup
+   */
+  void edge(const Point& aPoint, const Vector& aDir, const std::vector<std::size_t>& aGroup,
+	    std::size_t aFirst, std::vector<std::vector<Point> >& aVertices,
+	    std::vector<Point>& aNext) const
+  {
+    std::vector<Point> points;
+    typename Shape::RayCursor cursor = myShape.cursor(aPoint, aDir);
+    while (cursor.nextValue() >= 0)
+      {
+	points.push_back(cursor.point());
+	cursor.advance();
+      }
+    for (std::size_t i = aFirst; i < aGroup.size(); i++)
+      {
+	// Convex Hull case, we do not add the vertex
+	if (myPredicates[aGroup[i]].getDen2() != 0)
+	  aVertices[i].insert(aVertices[i].end(), points.begin(), points.end());
+	aNext[i] = cursor.point();
+      }
+  }
+
+public:
+  ///////////////////// main methods ///////////////////
+  /**
+   * Given a vertex shared by several alpha-shapes, retrieves
+   * for each of them a sequence of consecutive vertices
+   * in a counter-clockwise order, like the method next of
+   * IncrementalNegativeAlphaShape, in a single convergent loop.
+   *
+   * @param aPoint any vertex of the alpha-shapes
+   * @param aGroup indices of the predicates, in an increasing order
+   * @param aVertices (returned) for each alpha of @a aGroup, the
+   * retrieved vertices, except the last one
+   * @param aNext (returned) for each alpha of @a aGroup,
+   * the last retrieved vertex
+   */
+  void next(const Point& aPoint, const std::vector<std::size_t>& aGroup,
+	    std::vector<std::vector<Point> >& aVertices, std::vector<Point>& aNext)
+  {
+    aVertices.assign(aGroup.size(), std::vector<Point>());
+    aNext.assign(aGroup.size(), aPoint);
+    //the alphas of the group from this position have no vertex yet
+    std::size_t first = 0;
+
+    // Initialisation of the convergents.
+    Point vConvM2 = Point(1,0); //(k-2)-th convergent
+    Point vConvM1 = Point(0,1); //(k-1)-th convergent
+
+    // Orientation of the first convergents.
+    // vConvM2 outside and vConvM1 inside
+    Transformer2D<Point> rotation;
+    while (myShape(aPoint + vConvM2) > 0 || myShape(aPoint + vConvM1) < 0)
+      {
+	vConvM2 = rotation(vConvM2);
+	vConvM1 = rotation(vConvM1);
+      }
+    Point pConvM2 = aPoint + vConvM2;
+    Point pConvM1 = aPoint + vConvM1;
+    int k = 0;
+    Coordinate qk;
+    Point pConv;
+
+    //Ray casting from pConvM2 in the direction vConvM1
+    while (myShape.dray(pConvM2, vConvM1, qk, pConv))
+      {
+	if (myShape(pConv) < 0)
+	  {
+	    if (k > 0 && qk <= 0)
+	      {
+		edge(pConvM1, vConvM1, aGroup, first, aVertices, aNext);
+		return;
+	      }
+	  }
+	else if (k % 2 == 0)
+	  { //pConv is a vertex of all alpha-shapes,
+	    //with vertices of the form aPoint + i * vConvM1 before it
+	    for (std::size_t i = first; i < aGroup.size(); i++)
+	      {
+		const Predicate& predicate = myPredicates[aGroup[i]];
+		if ( !predicate(aPoint, pConv - vConvM1, pConv) )
+		  {
+		    Coordinate qks = AlphaShape::dichotomicSearch(predicate, aPoint, vConvM2, vConvM1, qk);
+		    for (Coordinate q = 1; q <= qk - qks; q++)
+		      aVertices[i].push_back(aPoint + vConvM1*q);
+		  }
+		aNext[i] = pConv;
+	      }
+	    return;
+	  }
+	else
+	  { //the alpha-shapes have vertices of the form pConvM2 + i * vConvM1
+	    //if the predicate is false, ie. for the smallest radii
+	    std::size_t lo = first, hi = aGroup.size();
+	    while (lo < hi)
+	      {
+		std::size_t mid = (lo + hi) / 2;
+		if ( myPredicates[aGroup[mid]](aPoint, pConv, pConv - vConvM1) )
+		  hi = mid;
+		else
+		  lo = mid + 1;
+	      }
+	    for (std::size_t i = first; i < lo; i++)
+	      {
+		const Predicate& predicate = myPredicates[aGroup[i]];
+		Coordinate qkalpha = AlphaShape::dichotomicSearch(predicate, aPoint, vConvM2, vConvM1, qk);
+		if (qkalpha == 0)
+		  aNext[i] = pConvM2;
+		else
+		  {
+		    for (Coordinate q = qkalpha; q < qk; q++)
+		      aVertices[i].push_back(pConvM2 + vConvM1*q);
+		    aNext[i] = pConv;
+		  }
+	      }
+	    first = lo;
+	    if (first == aGroup.size())
+	      return;
+	  }
+
+	k++;
+	pConvM2 = pConvM1;
+	pConvM1 = pConv;
+	vConvM2 = vConvM1;
+	vConvM1 = pConv-aPoint;
+      }
+    edge(pConvM1, vConvM1, aGroup, first, aVertices, aNext);
+  }
+
+  /**
+   * Retrieves all the vertices of the alpha-shapes
+   * in a counter-clockwise order from a given vertex
+   *
+   * @param aStartingPoint a vertex of the convex hull
+   * @param res output iterators, one for each predicate,
+   * that store the sequences of vertices
+   */
+  template <typename OutputIterator>
+  void all(const Point& aStartingPoint, std::vector<OutputIterator>& res)
+  {
+    std::size_t n = myPredicates.size();
+    ASSERT( (res.size() == n) && "Error in MultiNegativeAlphaShape: one output per predicate" );
+
+    //vertices from the first vertex to the end of the
+    //fundamental sector if the shape is symmetric
+    DiscSymmetry<Shape> symmetry(myShape, aStartingPoint);
+    bool isSymmetric = ( (myIsSymmetric) && (symmetry.getOrder() > 1) );
+    const Point first = (isSymmetric)?symmetry.getFirstVertex():aStartingPoint;
+    std::vector<std::vector<Point> > arcs(n);
+    std::vector<bool> isInSector(n, false), isComplete(n, false), isDone(n, false);
+
+    //current vertex of each alpha-shape and vertex of the
+    //convex hull reached by the alpha-shapes that are ahead
+    std::vector<Point> current(n, first);
+    Point frontier = first;
+    std::vector<std::vector<Point> > vertices;
+    std::vector<Point> nexts;
+    while (true)
+      {
+	//alpha-shapes at the same vertex, behind the frontier if any
+	std::size_t i = 0;
+	while ( (i < n) && ( (isDone[i]) || (current[i] == frontier) ) )
+	  i++;
+	if (i == n)
+	  {
+	    i = 0;
+	    while ( (i < n) && (isDone[i]) )
+	      i++;
+	    if (i == n)
+	      break;
+	  }
+	const Point p = current[i];
+	std::vector<std::size_t> group;
+	for (std::size_t j = i; j < n; j++)
+	  if ( (!isDone[j]) && (current[j] == p) )
+	    group.push_back(j);
+
+	next(p, group, vertices, nexts);
+	if (p == frontier)
+	  frontier = nexts.back();
+	for (std::size_t g = 0; g < group.size(); g++)
+	  {
+	    std::size_t j = group[g];
+	    vertices[g].insert(vertices[g].begin(), p);
+	    for (std::size_t l = 0; (l < vertices[g].size()) && (!isComplete[j]); l++)
+	      {
+		if (!isSymmetric)
+		  *res[j]++ = vertices[g][l];
+		else
+		  {
+		    if (symmetry.isInSector(vertices[g][l]))
+		      isInSector[j] = true;
+		    else if (isInSector[j])
+		      isComplete[j] = true;
+		    if (!isComplete[j])
+		      arcs[j].push_back(vertices[g][l]);
+		  }
+	      }
+	    current[j] = nexts[g];
+	    isDone[j] = ( (isComplete[j]) || (current[j] == first) );
+	  }
+      }
+
+    if (isSymmetric)
+      for (std::size_t j = 0; j < n; j++)
+	{
+	  if (isComplete[j])
+	    symmetry.unfold(arcs[j], aStartingPoint, res[j]);
+	  else //all the vertices are retrieved
+	    symmetry.rotate(arcs[j], aStartingPoint, res[j]);
+	}
+  }
+
+  /**
+   * Retrieves all the vertices of the alpha-shapes
+   * in a counter-clockwise order
+   *
+   * @param res output iterators, one for each predicate,
+   * that store the sequences of vertices
+   */
+  template <typename OutputIterator>
+  void all(std::vector<OutputIterator>& res)
+  {
+    all(myShape.getConvexHullVertex(), res);
+  }
+
+};
+#endif
@@ -2,8 +2,18 @@
 #define OutputSensitiveConvexHull_h
 
 #include<cmath>
+#include<vector>
+#include<algorithm>
+#include<iterator>
+#include<future>
+#include<thread>
+#include<iostream>
+#include<chrono>
 
 #include "BasicHelpers.h"
+#include "IntegerHelpers.h"
+#include "DiscSymmetry.h"
+#include "VertexRange.h"
 
 /**
  * Class implementing an on-line and ouput-sensitive algorithm
@@ -13,17 +23,92 @@
  * a ray emanating from a given point along a given direction
  * is computable.
  * 
+ * The search of a vertex is warm started from the edge ending
+ * at the previous vertex, since consecutive edges have close 
+ * slopes: the continued fraction expansion starts from 
+ * this edge and its unimodular complement instead of 
+ * the axis-aligned vectors (1,0) and (0,1). 
+ * 
+ * If the set of digital points lying inside the shape
+ * is symmetric (see DiscSymmetry), only the vertices of 
+ * a fundamental sector are retrieved by the method all, 
+ * the other ones being obtained by symmetry. 
+ * 
  * @tparam TShape a model of ray-intersectable shape.  
+ * @tparam TInteger a model of integer used for the orientation
+ * tests, ie. able to represent the product of two coordinates
+ * (128-bit integers by default, so that 64-bit coordinates
+ * can be used end to end).
  *
  */
-template <typename TShape, typename T = long long int>
+template <typename TShape, typename TInteger = Int128>
 class OutputSensitiveConvexHull 
 {
 public: 
   /////////////////////// inner types /////////////////
   typedef TShape Shape; 
   typedef typename Shape::Point Point; 
-  typedef Determinant<DGtal::BigInteger> Orientation; 
+  typedef typename Point::Coordinate Coordinate; 
+  typedef TInteger Integer; 
+  typedef Determinant<Integer> Orientation; 
+
+  /**
+   * State of an enumeration of the vertices, which may be 
+   * interrupted and resumed later (see start and resume), 
+   * possibly by another process: the state only consists of
+   * points and counters, which are written to and read from
+   * a stream. The shape is not stored and must be the same 
+   * when the enumeration is resumed. 
+   */
+  class State
+  {
+  public: 
+    Point myStartingPoint;  /* first vertex */
+    Point myCurrent;        /* next vertex to retrieve */
+    Point myLastEdge;       /* primitive direction of the edge ending at myCurrent */
+    bool myHasLastEdge;     /* 'true' if myLastEdge is known */
+    bool myVertOnEdges;     /* 'true' if the points lying on the edges are retrieved */
+    bool myIsComplete;      /* 'true' if all the vertices are retrieved */
+    unsigned long long myNbVertices; /* number of retrieved vertices */
+
+    /**
+     * Default constructor
+     */
+    State()
+      : myStartingPoint(0,0), myCurrent(0,0), myLastEdge(0,0), myHasLastEdge(false), 
+	myVertOnEdges(false), myIsComplete(false), myNbVertices(0) {}
+
+    /**
+     * Writes the state as a line of integers
+     * @param out output stream
+     */
+    void write(std::ostream& out) const
+    {
+      out << myStartingPoint[0] << " " << myStartingPoint[1] << " "
+	  << myCurrent[0] << " " << myCurrent[1] << " "
+	  << myLastEdge[0] << " " << myLastEdge[1] << " "
+	  << myHasLastEdge << " " << myVertOnEdges << " " 
+	  << myIsComplete << " " << myNbVertices << std::endl; 
+    }
+
+    /**
+     * Reads a state written by write
+     * @param in input stream
+     * @return 'true' if the reading succeeded, 'false' otherwise
+     */
+    bool read(std::istream& in)
+    {
+      Coordinate x0, y0, x1, y1, x2, y2; 
+      in >> x0 >> y0 >> x1 >> y1 >> x2 >> y2 
+	 >> myHasLastEdge >> myVertOnEdges >> myIsComplete >> myNbVertices; 
+      if (!in)
+	return false; 
+      myStartingPoint = Point(x0, y0); 
+      myCurrent = Point(x1, y1); 
+      myLastEdge = Point(x2, y2); 
+      return true; 
+    }
+  }; 
 private: 
   /////////////////////// members /////////////////////
   /**
@@ -31,6 +116,20 @@ private:
    */
   const Shape& myShape;  
 
+  /**
+   * Last vertex returned by next and primitive direction 
+   * of the edge ending at this vertex
+   */
+  Point myLastVertex; 
+  Point myLastEdge; 
+  bool myHasLastEdge; 
+
+  /**
+   * 'true' if the symmetries of the shape are used
+   * by the method all (see setSymmetry)
+   */
+  bool myIsSymmetric; 
+
 public:
   ///////////////////// standard services /////////////
   /**
@@ -38,7 +137,8 @@ public:
    * @param aShape
    */
   OutputSensitiveConvexHull(const Shape& aShape)
-    : myShape(aShape) {}
+    : myShape(aShape), myLastVertex(0,0), myLastEdge(0,0), myHasLastEdge(false), 
+      myIsSymmetric(true) {}
 
 private:
   /**
@@ -61,6 +161,94 @@ public:
    */
   ~OutputSensitiveConvexHull() {}
 
+  /**
+   * Enables or disables the use of the symmetries 
+   * of the shape by the method all (enabled by default)
+   * @param aFlag 'true' to enable the use of the symmetries
+   */
+  void setSymmetry(bool aFlag) { myIsSymmetric = aFlag; }
+
+private: 
+  /**
+   * Translates a point along a direction as long as
+   * the next point lies inside the shape. The values are
+   * updated by the ray cursor of the shape. 
+   * @param aPoint any point
+   * @param aDir translation direction
+   * @return last point of the form @a aPoint + k * @a aDir
+   * such that all the points between them lie inside the shape
+   */
+  Point extend(const Point& aPoint, const Point& aDir) const
+  {
+    typename Shape::RayCursor cursor = myShape.cursor(aPoint, aDir); 
+    while (cursor.nextValue() >= 0)
+      cursor.advance(); 
+    return cursor.point(); 
+  }
+
+  /**
+   * Computes the first two convergents from the edge ending at
+   * @a aPoint, if @a aPoint is the last vertex returned by next. 
+   * Let u be the primitive direction of this edge, 
+   * the second convergent is the vector w such that det(u,w) = 1, 
+   * @a aPoint + w lies inside the shape and @a aPoint + w + u 
+   * lies outside, found by one ray casting along u. 
+   * Since the vectors u, w, -u, -w are in counter-clockwise order, 
+   * they play the role of (1,0), (0,1), (-1,0), (0,-1), 
+   * up to a unimodular transformation. 
+   * @param aPoint any vertex of the convex hull
+   * @param aConvM2 (returned) first convergent, lying outside
+   * @param aConvM1 (returned) second convergent, lying inside
+   * @return 'true' if the convergents have been computed, 
+   * 'false' if the search must start from the axis-aligned vectors
+   */
+  bool warmStart(const Point& aPoint, Point& aConvM2, Point& aConvM1) const
+  {
+    if ( (!myHasLastEdge) || (aPoint != myLastVertex) )
+      return false; 
+    const Point& u = myLastEdge; 
+    if (myShape(aPoint + u) >= 0)
+      return false; //the edge goes on
+    
+    //w such that det(u,w) = u0 s + u1 t = 1
+    Coordinate s, t; 
+    extendedGreatestCommonDivisor(u[0], u[1], s, t); 
+    Point w(-t, s); 
+    //translation along u, so that w lies just behind aPoint, 
+    //ie. -u.u < w.u <= 0
+    Integer u0 = u[0], u1 = u[1], w0 = w[0], w1 = w[1]; 
+    Integer k = floorDivision( Integer(-(u0*w0 + u1*w1)), Integer(u0*u0 + u1*u1) ); 
+    w.addScaled( u, (Coordinate) IntegerTraits<Integer>::castToInt64(k) ); 
+    if (myShape(aPoint + w) < 0)
+      return false; 
+
+    //last point inside along u
+    Coordinate q = 0; 
+    Point p; 
+    if (!myShape.dray(aPoint + w, u, q, p))
+      return false; 
+    aConvM2 = u; 
+    aConvM1 = p - aPoint; 
+    return true; 
+  }
+
+  /**
+   * Stores the vertex returned by next, 
+   * together with the edge ending at it
+   * @param aVertex vertex returned by next
+   * @param aDir direction of the edge ending at @a aVertex
+   * @return @a aVertex
+   */
+  Point record(const Point& aVertex, const Point& aDir)
+  {
+    Coordinate g = greatestCommonDivisor(aDir[0], aDir[1]); 
+    myLastEdge = Point(aDir[0]/g, aDir[1]/g); 
+    myLastVertex = aVertex; 
+    myHasLastEdge = true; 
+    return aVertex; 
+  }
+
+public: 
 
   ///////////////////// main methods ///////////////////
   /**
@@ -73,29 +261,40 @@ public:
   Point next(const Point& aPoint, bool aVertOnEdges = false)
   {
       
-    // Initialisation of the convergents.
-    Point vConvM2 = Point(1,0); //(k-2)-th convergent
-    Point vConvM1 = Point(0,1); //(k-1)-th convergent
+    Point vConvM2; //(k-2)-th convergent
+    Point vConvM1; //(k-1)-th convergent
 
     // pConv is the k-th convergent such that 
     // pConv = pConvM2 + qk * vConvM1.
-    int qk = 0;
+    Coordinate qk = 0;
 
     Point pConv;
     Point vConv;
 
     // determinant result
-    DGtal::BigInteger res; 
+    Integer res; 
 
-    // Orientation of the convergent
-    // vConvM2 outside and vConvM1 inside
-      
-    Transformer2D<Point> rotation;       
-    while (myShape(aPoint + vConvM2) > 0 || myShape(aPoint + vConvM1) < 0)
+    // the edge ending at aPoint goes on
+    if ( (aVertOnEdges) && (myHasLastEdge) && (aPoint == myLastVertex) 
+	 && (myShape(aPoint + myLastEdge) >= 0) )
+      return record(aPoint + myLastEdge, myLastEdge); 
+
+    if (!warmStart(aPoint, vConvM2, vConvM1))
       {
-        // pi/2 counter clockwise rotation
-        vConvM2 = rotation(vConvM2);
-        vConvM1 = rotation(vConvM1);
+        // Initialisation of the convergents.
+        vConvM2 = Point(1,0); 
+        vConvM1 = Point(0,1); 
+
+        // Orientation of the convergent
+        // vConvM2 outside and vConvM1 inside
+      
+        Transformer2D<Point> rotation;       
+        while (myShape(aPoint + vConvM2) > 0 || myShape(aPoint + vConvM1) < 0)
+          {
+            // pi/2 counter clockwise rotation
+            vConvM2 = rotation(vConvM2);
+            vConvM1 = rotation(vConvM1);
+          }
       }
 
     // First convergent points      
@@ -112,9 +311,9 @@ public:
     if (myShape.dray(pConvM2, vConvM1, qk, pConv) == false)
       {
         if (!aVertOnEdges) 
-          while(myShape(pConvM1+vConvM1) >= 0){pConvM1 += vConvM1;}
+          pConvM1 = extend(pConvM1, vConvM1);
           
-        return (pConvM1);
+        return record(pConvM1, vConvM1);
       }
 
     // p0 lie on the circle
@@ -205,10 +404,136 @@ public:
     // in order to not keep the vertices 
     // on the convex hull edges
     if (!aVertOnEdges) 
-      while(myShape(pNext+vNext) >= 0){pNext += vNext;}
+      pNext = extend(pNext, vNext);
       
-    return pNext; 
+    return record(pNext, vNext); 
+
+  }
+
+  /**
+   * Given a vertex of the convex hull, find the next
+   * vertex in a counter-clockwise order (same interface 
+   * as IncrementalNegativeAlphaShape::next, see VertexRange)
+   * @param aPoint any vertex of the convex hull
+   * @param res output iterator, which is not used since
+   * there is no vertex between two consecutive vertices
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @return the next vertex
+   */
+  template <typename OutputIterator>
+  Point next(const Point& aPoint, OutputIterator /*res*/, bool aVertOnEdges)
+  {
+    return next(aPoint, aVertOnEdges); 
+  }
 
+  /**
+   * Lazy range over the vertices of the convex hull
+   * in a counter-clockwise order from a given vertex: 
+   * each vertex is only computed when the iterator 
+   * reaches it (see VertexRange). 
+   *  
+   * @param aStartingPoint a vertex of the convex hull
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @return range of vertices
+   */
+  VertexRange<OutputSensitiveConvexHull> vertices(const Point& aStartingPoint, bool aVertOnEdges = false)
+  {
+    return VertexRange<OutputSensitiveConvexHull>(*this, aStartingPoint, aVertOnEdges); 
+  }
+
+  /**
+   * Lazy range over the vertices of the convex hull
+   * in a counter-clockwise order
+   *  
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @return range of vertices
+   */
+  VertexRange<OutputSensitiveConvexHull> vertices(bool aVertOnEdges = false)
+  {
+    return vertices(myShape.getConvexHullVertex(), aVertOnEdges); 
+  }
+
+  /**
+   * Starts an enumeration of the vertices of the convex hull
+   * in a counter-clockwise order from a given vertex
+   * (no vertex is retrieved, see resume)
+   *  
+   * @param aStartingPoint a vertex of the convex hull
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @return state of the enumeration
+   */
+  State start(const Point& aStartingPoint, bool aVertOnEdges = false) const
+  {
+    State state; 
+    state.myStartingPoint = aStartingPoint; 
+    state.myCurrent = aStartingPoint; 
+    state.myVertOnEdges = aVertOnEdges; 
+    return state; 
+  }
+
+  /**
+   * Starts an enumeration of the vertices of the convex hull
+   * in a counter-clockwise order (see resume)
+   *  
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @return state of the enumeration
+   */
+  State start(bool aVertOnEdges = false) const
+  {
+    return start(myShape.getConvexHullVertex(), aVertOnEdges); 
+  }
+
+  /**
+   * Resumes an enumeration of the vertices of the convex hull
+   * until it is complete or the budget is exhausted, 
+   * ie. @a aMaxVertices vertices have been retrieved 
+   * or @a aMaxSeconds seconds have elapsed (at least one vertex
+   * is retrieved at each call, so that the enumeration progresses). 
+   * The state is updated, so that the next call retrieves the 
+   * following vertices, and the search of the next vertex is warm 
+   * started from the last edge as in an uninterrupted enumeration. 
+   *  
+   * @param aState state of the enumeration (see start)
+   * @param res output iterator that stores the retrieved vertices
+   * @param aMaxVertices maximal number of retrieved vertices
+   * (0 for no limit)
+   * @param aMaxSeconds maximal duration in seconds (0 for no limit)
+   * @return 'true' if the enumeration is complete, 'false' otherwise
+   */
+  template <typename OutputIterator>
+  bool resume(State& aState, OutputIterator res, 
+	      unsigned long long aMaxVertices = 0, double aMaxSeconds = 0)
+  {
+    typedef std::chrono::steady_clock Clock; 
+    const Clock::time_point deadline = Clock::now() 
+      + std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>(aMaxSeconds) ); 
+
+    //warm start from the last edge
+    myLastVertex = aState.myCurrent; 
+    myLastEdge = aState.myLastEdge; 
+    myHasLastEdge = aState.myHasLastEdge; 
+
+    unsigned long long nb = 0; 
+    while (!aState.myIsComplete)
+      {
+	if ( (nb > 0) 
+	     && ( ( (aMaxVertices > 0) && (nb >= aMaxVertices) ) 
+		  || ( (aMaxSeconds > 0) && (Clock::now() >= deadline) ) ) )
+	  break; 
+	*res++ = aState.myCurrent; 
+	nb++; 
+	aState.myNbVertices++; 
+	aState.myCurrent = next(aState.myCurrent, aState.myVertOnEdges); 
+	aState.myIsComplete = (aState.myCurrent == aState.myStartingPoint); 
+      }
+    aState.myLastEdge = myLastEdge; 
+    aState.myHasLastEdge = myHasLastEdge; 
+    return aState.myIsComplete; 
   }
 
   /**
@@ -221,6 +546,30 @@ public:
   template <typename OutputIterator>
   void all(const Point& aStartingPoint, OutputIterator res, bool aVertOnEdges)
   {
+    DiscSymmetry<Shape> symmetry(myShape, aStartingPoint); 
+    if ( (myIsSymmetric) && (symmetry.getOrder() > 1) )
+      {
+	//vertices from the first vertex to the 
+	//end of the fundamental sector
+	std::vector<Point> arc; 
+	bool isInSector = false; 
+	const Point first = symmetry.getFirstVertex(); 
+	Point tmp = first; 
+	do {
+	  if (symmetry.isInSector(tmp))
+	    isInSector = true; 
+	  else if (isInSector)
+	    break; 
+	  arc.push_back(tmp); 
+	  tmp = next(tmp, aVertOnEdges); 
+	} while (tmp != first); 
+	if (tmp == first) //all the vertices are retrieved
+	  symmetry.rotate(arc, aStartingPoint, res); 
+	else
+	  symmetry.unfold(arc, aStartingPoint, res); 
+	return; 
+      }
+
     //get the first vertex
     Point tmp = aStartingPoint; 
 
@@ -259,6 +608,170 @@ public:
   {
     all(myShape.getConvexHullVertex(), res, false); 
   }
+
+  /**
+   * Returns the vertex of the convex hull that maximizes the dot
+   * product with a given direction (support function query), 
+   * without enumerating the convex hull: the shape descends 
+   * directly to the supporting digital point (see getSupportingVertex
+   * of the shape), so that the cost does not depend on the number 
+   * of vertices. 
+   * @param aDirection any non-zero vector
+   * @param aIsLast 'true' to return the last vertex of an edge
+   * orthogonal to @a aDirection, 'false' to return the first one
+   * @return vertex of the convex hull
+   */
+  Point supportingVertex(const Point& aDirection, bool aIsLast = true) const
+  {
+    return myShape.getSupportingVertex(aDirection, aIsLast); 
+  }
+
+  /**
+   * Retrieves the vertices of the convex hull whose outward 
+   * normals lie in the angular sector going counter-clockwise 
+   * from @a aDirFrom to @a aDirTo, in a counter-clockwise order: 
+   * the first one supports @a aDirFrom and the last one 
+   * supports @a aDirTo (see getSupportingVertex of the shape). 
+   * The first vertex is directly located, without any walk along
+   * the convex hull, so that the cost only depends on the number 
+   * of retrieved vertices. If both directions are equal, only the 
+   * vertices supporting this direction are retrieved. 
+   *  
+   * @param aDirFrom first outward normal
+   * @param aDirTo last outward normal
+   * @param res output iterator that stores the sequence of vertices
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   */
+  template <typename OutputIterator>
+  void range(const Point& aDirFrom, const Point& aDirTo, OutputIterator res, 
+	     bool aVertOnEdges = false)
+  {
+    Point first = supportingVertex(aDirFrom, false); 
+    Point last = supportingVertex(aDirTo, true); 
+    *res++ = first; 
+    //the sector is contained in the normal cone of the vertex
+    if ( (first == last) && (Orientation::get(aDirFrom, aDirTo) >= 0) )
+      return; 
+    Point tmp = next(first, aVertOnEdges); 
+    while (tmp != first)
+      {
+	*res++ = tmp; 
+	if (tmp == last)
+	  return; 
+	tmp = next(tmp, aVertOnEdges); 
+      }
+  }
+
+  /**
+   * Retrieves all the vertices of the convex hull
+   * in a counter-clockwise order from the vertex returned
+   * by getConvexHullVertex, like all, but in parallel: 
+   * the walk is split into (at most) @a aNbTasks arcs 
+   * at the vertices supporting evenly spaced directions, 
+   * which are directly located (see supportingVertex), 
+   * each arc is retrieved by an asynchronous task, which works 
+   * on its own copy of the shape, and the arcs are concatenated. 
+   * If the digital disc is symmetric, only the walk along the 
+   * fundamental sector is split (see DiscSymmetry), 
+   * like in all. 
+   *  
+   * @param res output iterator that stores the sequence of vertices
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @param aNbTasks number of tasks, the number of concurrent 
+   * threads supported by the hardware if it is equal to 0 
+   */
+  template <typename OutputIterator>
+  void parallelAll(OutputIterator res, bool aVertOnEdges = false, unsigned int aNbTasks = 0)
+  {
+    if (aNbTasks == 0)
+      aNbTasks = std::max(1u, std::thread::hardware_concurrency()); 
+    const Point start = myShape.getConvexHullVertex(); 
+    DiscSymmetry<Shape> symmetry(myShape, start); 
+    bool isSymmetric = ( (myIsSymmetric) && (symmetry.getOrder() > 1) ); 
+
+    //the directions go counter-clockwise from (0,-1), 
+    //which is supported by the starting point, or 
+    //along the fundamental sector, from its first vertex
+    double from = -M_PI/2, span = 2*M_PI; 
+    std::vector<Point> splits; 
+    if (isSymmetric)
+      {
+	from = symmetry.getFirstRay()*M_PI/4; 
+	span = 2*M_PI/symmetry.getOrder(); 
+	splits.push_back( symmetry.getFirstVertex() ); 
+      }
+    else
+      splits.push_back( start ); 
+    for (unsigned int i = 1; i < aNbTasks; i++)
+      {
+	double angle = from + span*i/aNbTasks; 
+	Point dir( (Coordinate) std::floor(1024*std::cos(angle) + 0.5), 
+		   (Coordinate) std::floor(1024*std::sin(angle) + 0.5) ); 
+	Point p = supportingVertex(dir, true); 
+	//equal vertices are consecutive and the walk
+	//along the sector stops once it leaves it
+	if ( (p != splits.back()) && ( (!isSymmetric) || (symmetry.isInSector(p)) ) )
+	  splits.push_back(p); 
+      }
+    while ( (splits.size() > 1) && (splits.back() == splits.front()) )
+      splits.pop_back(); 
+    if (splits.size() < 2)
+      {
+	all(start, res, aVertOnEdges); 
+	return; 
+      }
+
+    std::vector<std::future<std::vector<Point> > > arcs; 
+    for (unsigned int i = 0; i < splits.size(); i++)
+      arcs.push_back( std::async( std::launch::async, &OutputSensitiveConvexHull::arc, 
+				  myShape, splits[i], splits[(i+1)%splits.size()], 
+				  aVertOnEdges, symmetry, ( (isSymmetric) && (i+1 == splits.size()) ) ) ); 
+    std::vector<Point> vertices; 
+    for (unsigned int i = 0; i < arcs.size(); i++)
+      {
+	std::vector<Point> arc = arcs[i].get(); 
+	vertices.insert(vertices.end(), arc.begin(), arc.end()); 
+      }
+
+    if (!isSymmetric)
+      std::copy(vertices.begin(), vertices.end(), res); 
+    else if (next(vertices.back(), aVertOnEdges) == splits.front())
+      symmetry.rotate(vertices, start, res); //all the vertices are retrieved
+    else
+      symmetry.unfold(vertices, start, res); 
+  }
+
+private: 
+  /**
+   * Retrieves the vertices of an arc of the convex hull
+   * in a counter-clockwise order (task of parallelAll)
+   *  
+   * @param aShape copy of the shape
+   * @param aFirst first vertex of the arc
+   * @param aLast last vertex of the arc, which is excluded
+   * @param aVertOnEdges 'true' if the points lying on the 
+   * edges are retrieved, 'false' otherwise
+   * @param aSymmetry symmetries of the shape
+   * @param aIsSectorEnd 'true' if the arc also ends at the first 
+   * vertex leaving the fundamental sector of @a aSymmetry, 
+   * 'false' otherwise
+   * @return the vertices from @a aFirst to @a aLast (excluded)
+   */
+  static std::vector<Point> arc(const Shape& aShape, const Point& aFirst, const Point& aLast, 
+				bool aVertOnEdges, const DiscSymmetry<Shape>& aSymmetry, 
+				bool aIsSectorEnd)
+  {
+    OutputSensitiveConvexHull ch(aShape); 
+    std::vector<Point> res; 
+    Point tmp = aFirst; 
+    do {
+      res.push_back(tmp); 
+      tmp = ch.next(tmp, aVertOnEdges); 
+    } while ( (tmp != aLast) && ( (!aIsSectorEnd) || (aSymmetry.isInSector(tmp)) ) ); 
+    return res; 
+  }
   
   
   
@@ -0,0 +1,533 @@
+#ifndef OutputSensitiveUnionConvexHull_h
+#define OutputSensitiveUnionConvexHull_h
+
+#include<cmath>
+#include<vector>
+#include<iterator>
+#include<algorithm>
+
+#include "BasicHelpers.h"
+#include "IntegerHelpers.h"
+#include "OutputSensitiveConvexHull.h"
+
+/**
+ * Class implementing an on-line and output-sensitive algorithm
+ * that retrieves the vertices of the convex hull of all digital
+ * points lying inside at least one shape of a set of
+ * ray-intersectable shapes, which also provide a support query,
+ * ie. a method getSupportingVertex (see ExactRayIntersectableCircle).
+ *
+ * The vertices are retrieved in a counter-clockwise order by
+ * gift wrapping. Along a chain of consecutive vertices belonging
+ * to the same shape, the candidate next vertex is found by ray
+ * casting, as in OutputSensitiveConvexHull. At the beginning of
+ * a chain, the arcs of normal directions for which the other shapes
+ * may reach the supporting lines of the shape of the chain are
+ * computed from their centers and radii (see getArcs), so that a
+ * support query only checks whether a shape whose arc is met by the
+ * normal of the candidate edge lies beyond it: if so, the bridge
+ * to this shape, ie. its vertex of tangency from the current vertex,
+ * is found by a dichotomic search on the normal directions (see
+ * tangent) and replaces the candidate.
+ *
+ * Beforehand, the shapes lying strictly inside the polygon whose
+ * vertices support the axis and diagonal directions are discarded,
+ * since they cannot contribute any vertex (see getBoundaryShapes).
+ * The convex hull of a shape is never computed as a whole.
+ *
+ * NB: the union must contain at least two digital points,
+ * as for OutputSensitiveConvexHull.
+ *
+ * @tparam TShape a model of ray-intersectable circle
+ * with a support query, whose center and radius are
+ * given by getCenterX(), getCenterY() and getRadius().
+ * @tparam TInteger a model of integer used for the orientation
+ * tests (see OutputSensitiveConvexHull).
+ */
+template <typename TShape, typename TInteger = Int128>
+class OutputSensitiveUnionConvexHull
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TShape Shape;
+  typedef typename Shape::Point Point;
+  typedef typename Point::Coordinate Coordinate;
+  typedef TInteger Integer;
+  typedef Determinant<Integer> Orientation;
+
+private:
+  /**
+   * Arc of normal directions, given by the angles from the
+   * normal of the edge ending at the first vertex of a chain,
+   * for which a shape may reach the supporting lines of the
+   * shape of the chain
+   */
+  struct Arc
+  {
+    double start;
+    double end;
+    std::size_t shape;
+
+    /**
+     * @return 'true' if the arc starts before @a other
+     */
+    bool operator<(const Arc& other) const
+    {
+      return (start < other.start);
+    }
+  };
+
+  /////////////////////// members /////////////////////
+  /**
+   * const reference on a set of shapes
+   */
+  const std::vector<Shape>& myShapes;
+
+  /**
+   * Indices of the shapes that may contribute a vertex
+   */
+  std::vector<std::size_t> myBoundaryShapes;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Standard constructor
+   * @param aShapes set of shapes
+   */
+  OutputSensitiveUnionConvexHull(const std::vector<Shape>& aShapes)
+    : myShapes(aShapes) {}
+
+private:
+  /**
+   * Copy constructor
+   * @param other other object to copy
+   */
+  OutputSensitiveUnionConvexHull(const OutputSensitiveUnionConvexHull& other) {}
+
+  /**
+   * Assignement operator
+   * @param other other object to copy
+   * @return reference on *this
+   */
+  OutputSensitiveUnionConvexHull& operator=(const OutputSensitiveUnionConvexHull& other)
+  { return *this; }
+
+public:
+  /**
+   * Default destructor
+   */
+  ~OutputSensitiveUnionConvexHull() {}
+
+  /**
+   * @return indices of the shapes that have not been discarded
+   * by the last call to all, because they may contribute a vertex
+   */
+  const std::vector<std::size_t>& getBoundaryShapes() const { return myBoundaryShapes; }
+
+private:
+  /**
+   * @param u any vector
+   * @param v any vector
+   * @return dot product between @a u and @a v
+   */
+  static Integer dot(const Point& u, const Point& v)
+  {
+    Integer u0 = u[0], u1 = u[1], v0 = v[0], v1 = v[1];
+    return (u0*v0 + u1*v1);
+  }
+
+  /**
+   * @param aDir direction of an edge of a polygon
+   * in a counter-clockwise order
+   * @return outward normal of the edge
+   */
+  static Point normal(const Point& aDir)
+  {
+    return Point(aDir[1], -aDir[0]);
+  }
+
+  /**
+   * Support query on the union of the boundary shapes
+   * @param aNormal any non-zero vector
+   * @param aVertex (returned) vertex of the convex hull having
+   * a maximal dot product with @a aNormal, the last one in a
+   * counter-clockwise order if there are two such vertices
+   * @return index of a shape of which @a aVertex is a vertex
+   */
+  std::size_t support(const Point& aNormal, Point& aVertex) const
+  {
+    Point u(-aNormal[1], aNormal[0]);
+    std::size_t res = myBoundaryShapes.front();
+    aVertex = myShapes[res].getSupportingVertex(aNormal);
+    for (std::size_t k = 1; k < myBoundaryShapes.size(); k++)
+      {
+	Point p = myShapes[myBoundaryShapes[k]].getSupportingVertex(aNormal);
+	Integer diff = dot(aNormal, p) - dot(aNormal, aVertex);
+	if ( (diff > 0) || ( (diff == 0) && (dot(u, p) > dot(u, aVertex)) ) )
+	  {
+	    res = myBoundaryShapes[k];
+	    aVertex = p;
+	  }
+      }
+    return res;
+  }
+
+  /**
+   * Discards the shapes lying strictly inside the polygon whose
+   * vertices support the axis and diagonal directions, which is
+   * contained in the convex hull, ie. the shapes whose support
+   * is lower than the one of the polygon for all its edge normals.
+   */
+  void discardInnerShapes()
+  {
+    myBoundaryShapes.clear();
+    for (std::size_t k = 0; k < myShapes.size(); k++)
+      myBoundaryShapes.push_back(k);
+
+    //polygon
+    Point dir(0,-1);
+    std::vector<Point> polygon;
+    for (int i = 0; i < 8; i++)
+      {
+	Point p;
+	support(dir, p);
+	if ( (polygon.empty()) || (polygon.back() != p) )
+	  polygon.push_back(p);
+	//rotation by pi/4 (up to a scaling)
+	dir = Point(dir[0] - dir[1], dir[0] + dir[1]);
+	Coordinate g = greatestCommonDivisor(dir[0], dir[1]);
+	dir = Point(dir[0]/g, dir[1]/g);
+      }
+    if ( (polygon.size() > 1) && (polygon.back() == polygon.front()) )
+      polygon.pop_back();
+    if (polygon.size() < 3)
+      return;
+
+    std::vector<std::size_t> boundaryShapes;
+    for (std::size_t k = 0; k < myShapes.size(); k++)
+      {
+	bool isInner = true;
+	for (std::size_t i = 0; ( (i < polygon.size()) && (isInner) ); i++)
+	  {
+	    const Point& p = polygon[i];
+	    Point n = normal( polygon[(i+1)%polygon.size()] - p );
+	    isInner = ( dot(n, myShapes[k].getSupportingVertex(n)) < dot(n, p) );
+	  }
+	if (!isInner)
+	  boundaryShapes.push_back(k);
+      }
+    myBoundaryShapes.swap(boundaryShapes);
+  }
+
+  /**
+   * @param aShape any shape
+   * @return 'true' if @a aShape contains a single digital point, 
+   * ie. its vertices supporting the axis directions are equal
+   */
+  static bool isSinglePoint(const Shape& aShape)
+  {
+    Point p = aShape.getSupportingVertex(Point(0,-1));
+    return ( (aShape.getSupportingVertex(Point(1,0)) == p)
+	     && (aShape.getSupportingVertex(Point(0,1)) == p)
+	     && (aShape.getSupportingVertex(Point(-1,0)) == p) );
+  }
+
+  /**
+   * @param aShape any shape
+   * @param aPoint a vertex of the convex hull
+   * @param aNormal normal of the candidate edge starting at @a aPoint
+   * @param aDir any direction
+   * @return 'true' if @a aDir lies after @a aNormal or if
+   * @a aShape lies beyond the line orthogonal to @a aDir
+   * passing through @a aPoint
+   */
+  bool isBeyond(const Shape& aShape, const Point& aPoint,
+		const Point& aNormal, const Point& aDir) const
+  {
+    return ( (Orientation::get(aNormal, aDir) > 0)
+	     || (dot(aDir, aShape.getSupportingVertex(aDir)) > dot(aDir, aPoint)) );
+  }
+
+  /**
+   * Computes the bridge from a vertex of the convex hull to
+   * a shape lying beyond the candidate edge starting at this
+   * vertex, ie. the vertex of tangency of the shape from this
+   * vertex. The normal n of the tangent line lies between the
+   * normal of the edge ending at the vertex, for which the shape
+   * is not beyond, and the normal of the candidate edge, for which
+   * the shape is beyond (see isBeyond), at most a half turn after. 
+   * The normal n is bracketed by two primitive vectors e1, e2 such 
+   * that det(e1,e2) = 1, starting from the first normal and its 
+   * Bezout partner, rotated further if it is not beyond, which
+   * are refined as in the Stern-Brocot tree, by exponential and
+   * dichotomic search along a same side, until the last vertex of
+   * the shape supporting e1 is equal to the first vertex supporting
+   * e2: this vertex supports n, hence it is the vertex of tangency,
+   * or until e1 is equal to n, ie. the line orthogonal to e1 passing
+   * through the vertex of the convex hull touches the shape ahead 
+   * of this vertex.
+   * @param aShape shape lying beyond the candidate edge
+   * @param aPoint a vertex of the convex hull
+   * @param aPrevNormal normal of the edge ending at @a aPoint
+   * @param aNormal normal of the candidate edge starting at @a aPoint
+   * @return vertex of tangency
+   */
+  Point tangent(const Shape& aShape, const Point& aPoint,
+		const Point& aPrevNormal, const Point& aNormal) const
+  {
+    //e1 along aPrevNormal and e2 such that det(e1,e2) = 1, 
+    //ie. e1[0] s + e1[1] t = 1, just behind the quarter turn
+    Coordinate g = greatestCommonDivisor(aPrevNormal[0], aPrevNormal[1]);
+    Point e1(aPrevNormal[0]/g, aPrevNormal[1]/g);
+    Coordinate s, t; 
+    extendedGreatestCommonDivisor(e1[0], e1[1], s, t); 
+    Point e2(-t, s); 
+    Integer u0 = e1[0], u1 = e1[1], w0 = e2[0], w1 = e2[1]; 
+    Integer k = floorDivision( Integer(-(u0*w0 + u1*w1)), Integer(u0*u0 + u1*u1) ); 
+    e2.addScaled( e1, (Coordinate) IntegerTraits<Integer>::castToInt64(k) ); 
+    if ( !isBeyond(aShape, aPoint, aNormal, e2) )
+      { //smallest q such that e2 - q e1 is beyond
+	Coordinate lo = 0, hi = 1;
+	while ( !isBeyond(aShape, aPoint, aNormal, e2.plusScaled(e1, -hi)) )
+	  {
+	    lo = hi;
+	    hi = 2*hi;
+	  }
+	while (hi - lo > 1)
+	  {
+	    Coordinate mid = (lo + hi) / 2;
+	    if ( isBeyond(aShape, aPoint, aNormal, e2.plusScaled(e1, -mid)) )
+	      hi = mid;
+	    else
+	      lo = mid;
+	  }
+	Point tmp = e1;
+	e1 = e2.plusScaled(tmp, -lo);
+	e2 = e2.plusScaled(tmp, -hi);
+      }
+
+    Point v1 = aShape.getSupportingVertex(e1, true);
+    Point v2 = aShape.getSupportingVertex(e2, false);
+    //e1 is the normal of the tangent line if it touches the shape 
+    //ahead of aPoint
+    while ( (v1 != v2) 
+	    && ( (dot(e1, v1) != dot(e1, aPoint)) 
+		 || (dot(Point(-e1[1], e1[0]), v1 - aPoint) <= 0) ) )
+      {
+	if ( !isBeyond(aShape, aPoint, aNormal, e1 + e2) )
+	  { //largest q such that e1 + q e2 is not beyond
+	    Coordinate lo = 1, hi = 2;
+	    while ( !isBeyond(aShape, aPoint, aNormal, e1.plusScaled(e2, hi)) )
+	      {
+		lo = hi;
+		hi = 2*hi;
+	      }
+	    while (hi - lo > 1)
+	      {
+		Coordinate mid = (lo + hi) / 2;
+		if ( isBeyond(aShape, aPoint, aNormal, e1.plusScaled(e2, mid)) )
+		  hi = mid;
+		else
+		  lo = mid;
+	      }
+	    Point tmp = e1;
+	    e1 = tmp.plusScaled(e2, lo);
+	    e2 = tmp.plusScaled(e2, hi);
+	  }
+	else
+	  { //largest q such that e2 + q e1 is beyond
+	    Coordinate lo = 1, hi = 2;
+	    while ( isBeyond(aShape, aPoint, aNormal, e2.plusScaled(e1, hi)) )
+	      {
+		lo = hi;
+		hi = 2*hi;
+	      }
+	    while (hi - lo > 1)
+	      {
+		Coordinate mid = (lo + hi) / 2;
+		if ( isBeyond(aShape, aPoint, aNormal, e2.plusScaled(e1, mid)) )
+		  lo = mid;
+		else
+		  hi = mid;
+	      }
+	    Point tmp = e1;
+	    e1 = e2.plusScaled(tmp, hi);
+	    e2 = e2.plusScaled(tmp, lo);
+	  }
+	v1 = aShape.getSupportingVertex(e1, true);
+	v2 = aShape.getSupportingVertex(e2, false);
+      }
+    return v1;
+  }
+
+  /**
+   * @param u any non-zero vector
+   * @param v any non-zero vector
+   * @return angle in [0, 2pi) from @a u to @a v
+   */
+  static double turn(const Point& u, const Point& v)
+  {
+    double a = std::atan2( IntegerTraits<Integer>::castToDouble( Orientation::get(u, v) ),
+			   IntegerTraits<Integer>::castToDouble( dot(u, v) ) );
+    return ( (a < 0)?(a + 2*M_PI):a );
+  }
+
+  /**
+   * Computes the arcs of normal directions for which the boundary
+   * shapes may reach the supporting lines of a given shape.
+   * The convex hull of the digital points of the i-th shape, of
+   * center c_i and radius r_i, has a support greater than
+   * <c_i,u> + r_i - min(sqrt(2), 2r_i) along any unit vector u,
+   * because any disc of radius sqrt(2)/2 contains a digital point,
+   * whereas the j-th shape has a support lower than <c_j,u> + r_j.
+   * The j-th shape may thus reach a supporting line of normal u
+   * only if <c_j - c_i,u> >= r_i - r_j - min(sqrt(2), 2r_i), which
+   * holds on an arc centered at the direction of c_j - c_i.
+   * The arcs are enlarged by a bound of the rounding errors.
+   * @param i index of a shape
+   * @param aNormal any normal direction, from which the angles are
+   * measured, in [0, 2pi) for the starts of the arcs
+   * @param res (returned) arcs, sorted by their start,
+   * an arc going through @a aNormal being split into two arcs
+   */
+  void getArcs(std::size_t i, const Point& aNormal, std::vector<Arc>& res) const
+  {
+    res.clear();
+    const Shape& shape = myShapes[i];
+    double x = shape.getCenterX(), y = shape.getCenterY(), r = shape.getRadius();
+    double angle = std::atan2( (double) aNormal[1], (double) aNormal[0] );
+    for (std::size_t k = 0; k < myBoundaryShapes.size(); k++)
+      {
+	const Shape& other = myShapes[myBoundaryShapes[k]];
+	if (myBoundaryShapes[k] == i)
+	  continue;
+	double dx = other.getCenterX() - x, dy = other.getCenterY() - y;
+	double dist = std::sqrt( dx*dx + dy*dy );
+	double eps = 1e-9 * ( std::abs(x) + std::abs(y) + r + other.getRadius() + 1 );
+	double lower = r - other.getRadius() - std::min( std::sqrt(2.0), 2*r ) - eps;
+	if (lower > dist)
+	  continue;
+	Arc arc;
+	arc.shape = myBoundaryShapes[k];
+	if (lower <= -dist)
+	  { //whole turn
+	    arc.start = 0;
+	    arc.end = 4*M_PI;
+	    res.push_back(arc);
+	    continue;
+	  }
+	double width = std::acos( lower / dist ) + 1e-9;
+	arc.start = std::atan2(dy, dx) - width - angle;
+	while (arc.start < 0)
+	  arc.start += 2*M_PI;
+	while (arc.start >= 2*M_PI)
+	  arc.start -= 2*M_PI;
+	arc.end = arc.start + 2*width;
+	res.push_back(arc);
+	if (arc.end > 2*M_PI)
+	  {
+	    arc.start = 0;
+	    arc.end -= 2*M_PI;
+	    res.push_back(arc);
+	  }
+      }
+    std::sort(res.begin(), res.end());
+  }
+
+public:
+
+  ///////////////////// main methods ///////////////////
+  /**
+   * Retrieves all the vertices of the convex hull
+   * in a counter-clockwise order, from the vertex
+   * of minimal y-coordinate (and maximal x-coordinate
+   * among them), like OutputSensitiveConvexHull::all
+   *
+   * @param res output iterator that stores the sequence of vertices
+   */
+  template <typename OutputIterator>
+  void all(OutputIterator res)
+  {
+    discardInnerShapes();
+
+    Point v0;
+    std::size_t i = support(Point(0,-1), v0);
+    Point v = v0;
+    Point prevNormal(0,-1);
+    std::vector<Arc> arcs;
+    std::vector<std::size_t> active;
+    while (true)
+      {
+	//chain of vertices belonging to the i-th shape
+	OutputSensitiveConvexHull<Shape, Integer> ch(myShapes[i]);
+	bool isPoint = isSinglePoint(myShapes[i]);
+	//the other shapes are only checked when the normal
+	//of the candidate edge goes through their arc
+	getArcs(i, prevNormal, arcs);
+	active.clear();
+	std::size_t nextArc = 0;
+	double angle = 0;
+	std::size_t k = i;
+	while (k == i)
+	  {
+	    *res++ = v;
+	    //candidate edge (or half-plane beyond the
+	    //edge ending at v if the shape is a single point)
+	    Point w = v;
+	    Point n = -prevNormal;
+	    if (!isPoint)
+	      {
+		w = ch.next(v);
+		n = normal(w - v);
+	      }
+	    //arcs met by the normals between prevNormal and n
+	    double nextAngle = angle + turn(prevNormal, n);
+	    for (std::size_t j = 0; j < active.size(); )
+	      {
+		if (arcs[active[j]].end < angle)
+		  {
+		    active[j] = active.back();
+		    active.pop_back();
+		  }
+		else
+		  j++;
+	      }
+	    for ( ; (nextArc < arcs.size()) && (arcs[nextArc].start <= nextAngle); nextArc++)
+	      if (arcs[nextArc].end >= angle)
+		active.push_back(nextArc);
+	    //bridges
+	    for (std::size_t j = 0; j < active.size(); j++)
+	      {
+		const Shape& shape = myShapes[arcs[active[j]].shape];
+		if (dot(n, shape.getSupportingVertex(n)) > dot(n, v))
+		  {
+		    w = tangent(shape, v, prevNormal, n);
+		    k = arcs[active[j]].shape;
+		    n = normal(w - v);
+		  }
+	      }
+	    //last vertex on the edge
+	    Point d = w - v;
+	    for (std::size_t j = 0; j <= active.size(); j++)
+	      {
+		std::size_t l = (j < active.size())?arcs[active[j]].shape:i;
+		Point p = myShapes[l].getSupportingVertex(n, true);
+		if ( (dot(n, p) == dot(n, v)) && (dot(d, p) > dot(d, w)) )
+		  {
+		    w = p;
+		    k = l;
+		  }
+	      }
+	    ASSERT( (w != v) && "Error in all of OutputSensitiveUnionConvexHull: single digital point" );
+	    angle += turn(prevNormal, n);
+	    prevNormal = n;
+	    v = w;
+	    if (v == v0)
+	      return;
+	  }
+	i = k;
+      }
+  }
+
+};
+#endif
@@ -2,6 +2,9 @@
   #define PointVector2D_h
 /**
  * Class implementing 2d point or vector strutures.
+ * The copy, assignment and destruction are the implicit ones, 
+ * so that the class is trivially copyable (and a literal type) 
+ * whenever T is (eg. for builtin integers). 
  * @tparam T a model of number (for the coordinates).  
  */
 template <typename T>
@@ -20,40 +23,14 @@ class PointVector2D
     /**
      * Default constructor
      */
-    PointVector2D(): myX(0), myY(0) {}
+    constexpr PointVector2D(): myX(0), myY(0) {}
 
     /**
      * Standard constructor
      * @param x x-coordinate
      * @param y y-coordinate
      */
-    PointVector2D(const T& x, const T& y): myX(x), myY(y) {}
-
-    /**
-     * Copy constructor
-     * @param p other object to copy
-     */
-    PointVector2D(const PointVector2D& p): myX(p.x()), myY(p.y()) {}
-
-    /**
-     * Assignement operator
-     * @param p other object to copy
-     * @return reference on *this
-     */
-    PointVector2D& operator=(const PointVector2D& p) 
-    {
-      if (p != *this)
-      {
-        myX = p.x(); 
-        myY = p.y(); 
-      }
-      return *this; 
-    }
-
-    /**
-     * Default destructor
-     */
-    ~PointVector2D() {}
+    constexpr PointVector2D(const T& x, const T& y): myX(x), myY(y) {}
 
     ///////////////////// read access ///////////////////
   private: 
@@ -61,13 +38,13 @@ class PointVector2D
      * x-coordinate accessor
      * @return x-coordinate. 
      */
-    T x() const { return myX; }
+    constexpr const T& x() const { return myX; }
 
     /**
      * y-coordinate accessor
      * @return y-coordinate. 
      */
-    T y() const { return myY; }
+    constexpr const T& y() const { return myY; }
 
   public: 
     /**
@@ -86,10 +63,9 @@ class PointVector2D
      * @param i index of the coordinates (0 for x-, 1 for y-)
      * @return reference on the coordinates of index i. 
      */
-    const T& operator[](const unsigned short& i) const 
+    constexpr const T& operator[](const unsigned short& i) const 
     { 
-      if (i == 0){ return myX; }
-      else { return myY; }
+      return (i == 0)?myX:myY; 
     }
 
     ///////////////////// comparisons ///////////////////
@@ -99,7 +75,7 @@ class PointVector2D
      * @return 'true' if the coordinates of *this and p
      * are pairwise equal, 'false' otherwise 
      */
-    bool operator==(const PointVector2D& p) const 
+    constexpr bool operator==(const PointVector2D& p) const 
     {
       return (myX == p.x() && myY == p.y());
     }
@@ -109,7 +85,7 @@ class PointVector2D
      * @param p object to compare with
      * @return 'false' if *this and p are equal
      */
-    bool operator!=(const PointVector2D& p) const 
+    constexpr bool operator!=(const PointVector2D& p) const 
     { 
       return (myX != p.x() || myY != p.y());
     }
@@ -120,7 +96,7 @@ class PointVector2D
      * @param p object to add 
      * @return the sum *this + p
      */
-    PointVector2D operator+(const PointVector2D& p) const 
+    constexpr PointVector2D operator+(const PointVector2D& p) const 
     { 
       return (PointVector2D(myX+p.x(), myY+p.y())); 
     }
@@ -128,12 +104,12 @@ class PointVector2D
     /**
      * Compound Addition assignment operator
      * @param p object to add 
-     * @return *this = *this + p
+     * @return reference on *this = *this + p
      */
-    PointVector2D operator+=(const PointVector2D& p)  
+    PointVector2D& operator+=(const PointVector2D& p)  
     { 
-      myX = myX + p.x();
-      myY = myY + p.y();
+      myX += p.x();
+      myY += p.y();
       return ( *this); 
     }
 
@@ -143,20 +119,20 @@ class PointVector2D
      * @param p object to substract 
      * @return the difference *this - p
      */
-    PointVector2D operator-(const PointVector2D& p) const
+    constexpr PointVector2D operator-(const PointVector2D& p) const
     { 
       return (PointVector2D(myX-p.x(), myY-p.y())); 
     }
 
     /**
      * Compound Substraction assignment operator
-     * @param p object to add 
-     * @return *this = *this + p
+     * @param p object to substract 
+     * @return reference on *this = *this - p
      */
-    PointVector2D operator-=(const PointVector2D& p)  
+    PointVector2D& operator-=(const PointVector2D& p)  
     { 
-      myX = myX - p.x();
-      myY = myY - p.y();
+      myX -= p.x();
+      myY -= p.y();
       return ( *this); 
     }
 
@@ -165,15 +141,41 @@ class PointVector2D
      * @param k scalar value all the coordinates are multiplied with
      * @return a points whose coordinates are multiplied with k
      */
-    PointVector2D operator*(const T& k) const
+    constexpr PointVector2D operator*(const T& k) const
     { 
       return (PointVector2D(k*myX, k*myY)); 
     }
+
+    /**
+     * Fused multiplication and addition (*this + k * v), 
+     * which does not build the intermediate vector k * v
+     * @param v vector to scale
+     * @param k scalar value the coordinates of v are multiplied with
+     * @return the point *this + k * v
+     */
+    constexpr PointVector2D plusScaled(const PointVector2D& v, const T& k) const
+    { 
+      return (PointVector2D(myX + k*v.x(), myY + k*v.y())); 
+    }
+
+    /**
+     * Compound fused multiplication and addition 
+     * @param v vector to scale
+     * @param k scalar value the coordinates of v are multiplied with
+     * @return reference on *this = *this + k * v
+     */
+    PointVector2D& addScaled(const PointVector2D& v, const T& k)
+    { 
+      myX += k*v.x();
+      myY += k*v.y();
+      return ( *this); 
+    }
+
     /**
      * Opposite operator
      * @return the opposite - *this
      */
-    PointVector2D operator-()  const
+    constexpr PointVector2D operator-()  const
     {
      return (PointVector2D(-myX, -myY));
     }
@@ -183,7 +185,7 @@ class PointVector2D
      * @param p object with which the dot product is computed
      * @return dot product *this . p
      */
-    T dot(const PointVector2D& p) const
+    constexpr T dot(const PointVector2D& p) const
     {
       return (p.x() * myX + p.y() * myY);
     }
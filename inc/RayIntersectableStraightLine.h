@@ -111,6 +111,70 @@ class RayIntersectableStraightLine
       return (myA*aPoint[0] + myB*aPoint[1] + myC);
     }
 
+    /**
+     * Class implementing a cursor moving along a digital ray, 
+     * which updates the value of the function by a constant
+     * difference (one addition per step).
+     */
+    class RayCursor
+    {
+      private: 
+        /////////////////////// members /////////////////////
+        Point myPoint;        /* current point */
+        Vector myDirection;   /* ray direction */
+        Value myValue;        /* value at the current point */
+        Value myDelta;        /* constant difference, ie. a d0 + b d1 */
+
+      public:
+        ///////////////////// standard services /////////////
+        /**
+         * Standard constructor
+         * @param aPoint current point
+         * @param aDirection ray direction
+         * @param aValue value at @a aPoint
+         * @param aDelta difference between two consecutive points
+         */
+        RayCursor(const Point& aPoint, const Vector& aDirection, 
+                  const Value& aValue, const Value& aDelta)
+          : myPoint(aPoint), myDirection(aDirection), myValue(aValue), myDelta(aDelta) {}
+
+        ///////////////////// main methods ///////////////////
+        /**
+         * @return current point
+         */
+        const Point& point() const { return myPoint; }
+
+        /**
+         * @return value at the current point
+         */
+        Value value() const { return myValue; }
+
+        /**
+         * @return value at the next point along the ray
+         */
+        Value nextValue() const { return myValue + myDelta; }
+
+        /**
+         * Moves the cursor to the next point along the ray
+         */
+        void advance()
+        {
+          myPoint += myDirection; 
+          myValue += myDelta; 
+        }
+    }; 
+
+    /**
+     * @param aPoint any point
+     * @param aDirection ray direction
+     * @return cursor lying at @a aPoint and moving along @a aDirection
+     */
+    RayCursor cursor(const Point& aPoint, const Vector& aDirection) const
+    {
+      return RayCursor(aPoint, aDirection, (*this)(aPoint), 
+                       myA*aDirection[0] + myB*aDirection[1]); 
+    }
+
     /**
      * Intersection between the straight-line and the digital ray
      *
@@ -124,7 +188,7 @@ class RayIntersectableStraightLine
      * @return 'true' if the ray and the straight-line instercest, 'false' otherwise 
      */
     bool dray(const Point& aStartingPoint, const Vector& aDirection, 
-             int& aQuotient, Point& aClosest) const 
+             Integer& aQuotient, Point& aClosest) const 
     {
       
       // Initialise value
@@ -0,0 +1,179 @@
+#ifndef VertexRange_h
+#define VertexRange_h
+
+#include <deque>
+#include <iterator>
+
+/**
+ * Class implementing a lazy range over the vertices retrieved
+ * by an on-line algorithm (OutputSensitiveConvexHull or
+ * IncrementalNegativeAlphaShape), in a counter-clockwise order
+ * from a given vertex.
+ * The vertices are computed on demand, when the iterator is
+ * incremented, so that the caller may stop as soon as it gets
+ * the vertices it needs, without paying for the other ones.
+ *
+ * The algorithm must provide a method
+ * Point next(const Point& aPoint, OutputIterator res, bool aFlag)
+ * returning the vertex following @a aPoint, while storing into
+ * @a res the vertices lying between them, if any.
+ * The iterator only stores the current vertex and the vertices
+ * lying between two consecutive calls to next (none for
+ * the convex hull).
+ *
+ * NB: the range is valid as long as the algorithm is. Since
+ * the iterators share the state of the algorithm (eg. its last
+ * edge), they are input iterators (single pass).
+ *
+ * Basic usage:
+ * @code
+ OutputSensitiveConvexHull<Shape> ch(shape);
+ VertexRange<OutputSensitiveConvexHull<Shape> > range = ch.vertices();
+ for (VertexRange<OutputSensitiveConvexHull<Shape> >::ConstIterator it = range.begin();
+      it != range.end(); ++it)
+   if (...) break;
+ * @endcode
+ *
+ * @tparam TAlgorithm type of the algorithm
+ */
+template <typename TAlgorithm>
+class VertexRange
+{
+public:
+  /////////////////////// inner types /////////////////
+  typedef TAlgorithm Algorithm;
+  typedef typename Algorithm::Point Point;
+
+  /**
+   * Input iterator over the vertices
+   */
+  class ConstIterator
+    : public std::iterator<std::input_iterator_tag, Point, std::ptrdiff_t,
+			   const Point*, const Point&>
+  {
+  private:
+    /////////////////////// members /////////////////////
+    Algorithm* myAlgorithm;    /* algorithm (null for the end iterator) */
+    Point myStartingPoint;     /* first vertex */
+    bool myFlag;               /* flag passed to the method next */
+    Point myCurrent;           /* current vertex */
+    Point myLast;              /* last vertex returned by next */
+    std::deque<Point> myPending; /* vertices retrieved but not yet visited */
+
+  public:
+    ///////////////////// standard services /////////////
+    /**
+     * Default constructor (end iterator)
+     */
+    ConstIterator()
+      : myAlgorithm(0), myStartingPoint(0,0), myFlag(false),
+	myCurrent(0,0), myLast(0,0) {}
+
+    /**
+     * Constructor
+     * @param aAlgorithm algorithm
+     * @param aStartingPoint first vertex
+     * @param aFlag flag passed to the method next
+     */
+    ConstIterator(Algorithm& aAlgorithm, const Point& aStartingPoint, bool aFlag)
+      : myAlgorithm(&aAlgorithm), myStartingPoint(aStartingPoint), myFlag(aFlag),
+	myCurrent(aStartingPoint), myLast(aStartingPoint) {}
+
+    ///////////////////// main methods ///////////////////
+    /**
+     * @return current vertex
+     */
+    const Point& operator*() const { return myCurrent; }
+
+    /**
+     * @return pointer to the current vertex
+     */
+    const Point* operator->() const { return &myCurrent; }
+
+    /**
+     * Moves to the next vertex, which is computed
+     * if it has not been retrieved yet. The iterator
+     * becomes equal to the end iterator when it comes
+     * back to the first vertex.
+     * @return reference on *this
+     */
+    ConstIterator& operator++()
+    {
+      if (myPending.empty())
+	{
+	  myLast = myAlgorithm->next(myLast, std::back_inserter(myPending), myFlag);
+	  myPending.push_back(myLast);
+	}
+      myCurrent = myPending.front();
+      myPending.pop_front();
+      if ( (myPending.empty()) && (myLast == myStartingPoint) )
+	myAlgorithm = 0;
+      return *this;
+    }
+
+    /**
+     * Moves to the next vertex (postfix version)
+     * @return copy of the iterator before the move
+     */
+    ConstIterator operator++(int)
+    {
+      ConstIterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    /**
+     * Equality operator, which is only meaningful
+     * for the comparison with the end iterator
+     * @param other other iterator
+     * @return 'true' if both iterators are at the end
+     * or point to the same vertex of the same algorithm
+     */
+    bool operator==(const ConstIterator& other) const
+    {
+      if ( (myAlgorithm == 0) || (other.myAlgorithm == 0) )
+	return (myAlgorithm == other.myAlgorithm);
+      return ( (myAlgorithm == other.myAlgorithm) && (myCurrent == other.myCurrent) );
+    }
+
+    /**
+     * Difference operator
+     * @param other other iterator
+     * @return 'true' if the iterators are not equal
+     */
+    bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+  };
+
+private:
+  /////////////////////// members /////////////////////
+  /**
+   * Algorithm, first vertex and flag passed to the method next
+   */
+  Algorithm& myAlgorithm;
+  Point myStartingPoint;
+  bool myFlag;
+
+public:
+  ///////////////////// standard services /////////////
+  /**
+   * Constructor
+   * @param aAlgorithm algorithm
+   * @param aStartingPoint first vertex
+   * @param aFlag flag passed to the method next
+   */
+  VertexRange(Algorithm& aAlgorithm, const Point& aStartingPoint, bool aFlag)
+    : myAlgorithm(aAlgorithm), myStartingPoint(aStartingPoint), myFlag(aFlag) {}
+
+  ///////////////////// main methods ///////////////////
+  /**
+   * @return iterator pointing to the first vertex
+   */
+  ConstIterator begin() const { return ConstIterator(myAlgorithm, myStartingPoint, myFlag); }
+
+  /**
+   * @return end iterator
+   */
+  ConstIterator end() const { return ConstIterator(); }
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <sstream>
+//containers and iterators
+#include <iterator>
+#include <vector>
+// random
+#include <cstdlib>
+#include <ctime>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Integers
+#include "../inc/Integer256.h"
+// Circles
+#include "../inc/ExactRayIntersectableCircle.h"
+#include "../inc/AdaptiveRayIntersectableCircle.h"
+// Convex Hull
+#include "../inc/OutputSensitiveConvexHull.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * Random integer in [-2^k, 2^k)
+ */
+long long randomInteger(int k)
+{
+  long long x = ( ( (long long) rand() << 31 ) ^ rand() ) & ( (1LL << k) - 1 );
+  return ( (rand()%2)?x:(-x-1) );
+}
+
+/**
+ * Conversion from Integer256 to DGtal::BigInteger
+ */
+DGtal::BigInteger toBigInteger(const Integer256& x)
+{
+  std::stringstream s;
+  s << x;
+  return DGtal::BigInteger( s.str() );
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<int> Point; //type redefinition
+  typedef PointVector2D<int> Vector; //type redefinition
+  typedef DGtal::BigInteger BigInteger;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+  std::cout << "256-bit integers" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    for (int i = 0; i < 1000; i++)
+      {
+	Integer256 x = Integer256( (Int128) randomInteger(60) ) * Integer256( (Int128) randomInteger(40) );
+	Integer256 y = Integer256( (Int128) randomInteger(50) ) * Integer256( (Int128) randomInteger(1 + i%50) );
+	BigInteger bx = toBigInteger(x), by = toBigInteger(y);
+	if ( (toBigInteger(x*y) == bx*by)
+	     && (toBigInteger(x+y) == bx+by) && (toBigInteger(x-y) == bx-by)
+	     && ( (y == 0) || (toBigInteger(x/y) == BigInteger(bx/by)) )
+	     && ( (x < y) == (bx < by) ) && ( (x == y) == (bx == by) )
+	     && (IntegerTraits<Integer256>::bitLength(x) == IntegerTraits<BigInteger>::bitLength(bx))
+	     && (toBigInteger( IntegerTraits<Integer256>::isqrt( x*x + y*y ) ) == BigInteger( sqrt(bx*bx + by*by) )) )
+	  nbLocalOk++;
+	nbLocal++;
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Division of -2^127 by -1" << std::endl;
+  {
+    //both operands fit in 128 bits, but not the quotient
+    Integer256 x = -( Integer256(1) << 127 );
+    if ( (toBigInteger(x / Integer256(-1)) == -toBigInteger(x))
+	 && (x % Integer256(-1) == 0) && (x / Integer256(1) == x) )
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Function and ray casting against the BigInteger circle" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    //coordinates are bounded so that the points
+    //evaluated along the rays fit in an int
+    for (int k = 2; k <= 24; k += 2)
+      {
+	for (int i = 0; i < 10; i++)
+	  {
+	    Point p( randomInteger(k), randomInteger(k) );
+	    Point q( p + Point( randomInteger(k), randomInteger(k) ) );
+	    Point r( p + Point( randomInteger(k), randomInteger(k) ) );
+	    ExactRayIntersectableCircle<Point, BigInteger> circle(p, q, r);
+	    if (circle.c() >= 0)
+	      circle = ExactRayIntersectableCircle<Point, BigInteger>(p, r, q);
+	    //flat triangles lead to too large circles
+	    if ( (circle.c() == 0) || (circle.getRadius() > (1 << (k+2))) )
+	      continue;
+	    AdaptiveRayIntersectableCircle<Point> adaptiveCircle(circle.a(), circle.b(), circle.c(), circle.d());
+
+	    for (int j = 0; j < 20; j++)
+	      {
+		Point s( p + Point( randomInteger(k), randomInteger(k) ) );
+		Vector dir( randomInteger(3), randomInteger(3) );
+		BigInteger v = circle(s);
+		int sign = (v > 0)?1:( (v < 0)?-1:0 );
+		int q1 = 0, q2 = 0;
+		Point c1, c2;
+		bool res1 = ( (dir != Vector(0,0)) && (circle.dray(s, dir, q1, c1)) );
+		bool res2 = ( (dir != Vector(0,0)) && (adaptiveCircle.dray(s, dir, q2, c2)) );
+		if ( (adaptiveCircle(s) == sign) && (res1 == res2)
+		     && ( (!res1) || ( (q1 == q2) && (c1 == c2) ) ) )
+		  nbLocalOk++;
+		nbLocal++;
+	      }
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Convex hull against the BigInteger circle" << std::endl;
+  {
+    for (int k = 4; k <= 12; k += 2)
+      {
+	ExactRayIntersectableCircle<Point, BigInteger> circle;
+	do
+	  {
+	    Point p( randomInteger(k), randomInteger(k) );
+	    Point q( p + Point( randomInteger(k), randomInteger(k) ) );
+	    Point r( p + Point( randomInteger(k), randomInteger(k) ) );
+	    circle = ExactRayIntersectableCircle<Point, BigInteger>(p, q, r);
+	    if (circle.c() >= 0)
+	      circle = ExactRayIntersectableCircle<Point, BigInteger>(p, r, q);
+	  }
+	while ( (circle.c() == 0) || (circle.getRadius() > (1 << (k+2))) );
+	AdaptiveRayIntersectableCircle<Point> adaptiveCircle(circle.a(), circle.b(), circle.c(), circle.d());
+
+	std::vector<Point> v1, v2;
+	OutputSensitiveConvexHull<ExactRayIntersectableCircle<Point, BigInteger> > ch1(circle);
+	ch1.all( std::back_inserter(v1) );
+	OutputSensitiveConvexHull<AdaptiveRayIntersectableCircle<Point> > ch2(adaptiveCircle);
+	ch2.all( std::back_inserter(v2) );
+#ifdef DEBUG_VERBOSE
+	std::copy(v2.begin(), v2.end(), std::ostream_iterator<Point>(std::cout, ", ") );
+	std::cout << std::endl;
+#endif
+	if ( (v1.size() == v2.size()) && (std::equal(v1.begin(), v1.end(), v2.begin())) )
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+//containers and iterators
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <deque>
+// random
+#include <cstdlib>
+#include <ctime>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Circle
+#include "../inc/ExactRayIntersectableCircle.h"
+// Alpha-shape
+#include "../inc/IncrementalNegativeAlphaShape.h"
+#include "../inc/AlphaSpectrum.h"
+#include "../inc/CircumcircleRadiusPredicate.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * @return 'true' if the alpha-shapes retrieved from the
+ * spectrum of @a aCircle are equal to the ones retrieved
+ * one by one, for all the predicates
+ */
+template <typename Circle, typename Predicate>
+bool test(const Circle& aCircle, const std::vector<Predicate>& aPredicates)
+{
+  typedef typename Circle::Point Point;
+
+  AlphaSpectrum<Circle, Predicate> spectrum(aCircle);
+#ifdef DEBUG_VERBOSE
+  std::cout << spectrum.size() << " boundary points" << std::endl;
+#endif
+
+  bool isOk = true;
+  for (unsigned int i = 0; i < aPredicates.size(); i++)
+    {
+      std::vector<Point> v, w;
+      spectrum.alphaShape( aPredicates[i], std::back_inserter(v) );
+      IncrementalNegativeAlphaShape<Circle, Predicate> as(aCircle, aPredicates[i]);
+      as.all( std::back_inserter(w) );
+#ifdef DEBUG_VERBOSE
+      std::cout << v.size() << " / " << w.size() << " vertices" << std::endl;
+#endif
+      if ( (v.size() != w.size()) || (!std::equal(w.begin(), w.end(), v.begin())) )
+	isOk = false;
+    }
+  return isOk;
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<int> Point; //type redefinition
+  typedef ExactRayIntersectableCircle<Point,  DGtal::BigInteger> Circle;
+  typedef CircumcircleRadiusPredicate<> Predicate;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+  //radii from sqrt(2)/2 to infinity
+  int nbPredicate = 12;
+  int valuePredicateNum[12] = {1, 4, 5, 10, 20, 200, 2000, 20000, 100000, 200000, 2000000, 3};
+  int valuePredicateDen[12] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0};
+  std::vector<Predicate> predicates;
+  for (int i = 0; i < nbPredicate; i++)
+    predicates.push_back( Predicate(valuePredicateNum[i], valuePredicateDen[i], false) );
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "1 - Circles through three random points" << std::endl;
+#endif
+  {
+    int maxPoint = 100;
+    for (int i = 0; i < 20; i++)
+      {
+	Point pta( (rand() % maxPoint), (rand() % maxPoint) );
+	Point ptb( (pta[0]-1- (rand() % maxPoint) ), (pta[1]-1- (rand() % maxPoint)) );
+	Point ptc( (ptb[0]+1+ (rand() % maxPoint) ), (ptb[1]-1- (rand() % maxPoint)) );
+	Circle circle( pta, ptb, ptc );
+	circle.normalize();
+	if (test(circle, predicates))
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "2 - Circles of integer or half-integer centers" << std::endl;
+#endif
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	//the center (-a/2c, -b/2c) has integer or half-integer coordinates
+	int c = -2;
+	int a = -c * (rand() % 100);
+	int b = -c * (rand() % 100);
+	int R = 2 + rand() % 100;
+	int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );
+	if (test(circle, predicates))
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "3 - Radii needing more than 64 bits" << std::endl;
+#endif
+  {
+    typedef CircumcircleRadiusPredicate<DGtal::BigInteger> BigPredicate;
+    DGtal::BigInteger num2(1);
+    num2 <<= 64;
+    std::vector<BigPredicate> bigPredicates;
+    bigPredicates.push_back( BigPredicate(num2 + 10, 2, false) );
+    bigPredicates.push_back( BigPredicate(num2*num2 + 1, 3, false) );
+    bigPredicates.push_back( BigPredicate(num2, num2/1000, false) );
+    int maxPoint = 100;
+    for (int i = 0; i < 5; i++)
+      {
+	Point pta( (rand() % maxPoint), (rand() % maxPoint) );
+	Point ptb( (pta[0]-1- (rand() % maxPoint) ), (pta[1]-1- (rand() % maxPoint)) );
+	Point ptc( (ptb[0]+1+ (rand() % maxPoint) ), (ptb[1]-1- (rand() % maxPoint)) );
+	Circle circle( pta, ptb, ptc );
+	circle.normalize();
+	if (test(circle, bigPredicates))
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
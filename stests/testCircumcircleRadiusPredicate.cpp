@@ -0,0 +1,250 @@
+#include <iostream>
+// random
+#include <cstdlib>
+#include <ctime>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Predicate
+#include "../inc/CircumcircleRadiusPredicate.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * Reference implementation of the predicate,
+ * which performs all computations with DGtal::BigInteger
+ */
+template <typename Point>
+bool referencePredicate(const DGtal::BigInteger& aNum2, const DGtal::BigInteger& aDen2,
+			const bool& aPositive,
+			const Point& a, const Point& b, const Point& c)
+{
+  typedef DGtal::BigInteger Integer;
+  Integer a0( (long) a[0] ), a1( (long) a[1] );
+  Integer b0( (long) b[0] ), b1( (long) b[1] );
+  Integer c0( (long) c[0] ), c1( (long) c[1] );
+
+  Integer area = a0*(b1 - c1) - b0*(a1 - c1) + c0*(a1 - b1);
+  if (area == 0)
+    return (aDen2 == 0 || aPositive);
+  if ( (aPositive && area > 0) || (!aPositive && area < 0) )
+    return aPositive;
+
+  Integer rightPart = ( (b0-a0)*(b0-a0) + (b1-a1)*(b1-a1) )
+    *( (c0-b0)*(c0-b0) + (c1-b1)*(c1-b1) )
+    *( (c0-a0)*(c0-a0) + (c1-a1)*(c1-a1) )*aDen2;
+  Integer leftPart = 4*area*area*aNum2;
+  return (aPositive == (leftPart < rightPart));
+}
+
+/**
+ * Random integer in [-2^k, 2^k)
+ */
+long long randomInteger(int k)
+{
+  long long x = ( ( (long long) rand() << 31 ) ^ rand() ) & ( (1LL << k) - 1 );
+  return ( (rand()%2)?x:(-x-1) );
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<long long> Point; //type redefinition
+  typedef DGtal::BigInteger BigInteger;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+  std::cout << "Tiered evaluation against BigInteger evaluation" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    //coordinates magnitude (in bits)
+    for (int k = 2; k <= 40; k += 2)
+      {
+	//radius magnitude (in bits)
+	for (int l = 0; l <= 2*k+4; l += 4)
+	  {
+	    long long num2 = (1LL << l) + (rand()%16);
+	    long long den2 = 1 + (rand()%3);
+	    for (int sign = 0; sign < 2; sign++)
+	      {
+		CircumcircleRadiusPredicate<long long> p1(num2, den2, (sign == 0));
+		CircumcircleRadiusPredicate<BigInteger> p2(BigInteger( (long) num2 ), BigInteger( (long) den2 ), (sign == 0));
+		for (int i = 0; i < 25; i++)
+		  {
+		    Point a( randomInteger(k), randomInteger(k) );
+		    //b and c close to a in order to get large circles
+		    Point b( a + Point( randomInteger(k/2), randomInteger(k/2) ) );
+		    Point c( b + (b - a) + Point( randomInteger(k/4), randomInteger(k/4) ) );
+		    bool ref = referencePredicate(BigInteger( (long) num2 ), BigInteger( (long) den2 ),
+						  (sign == 0), a, b, c);
+		    if ( (p1(a,b,c) == ref) && (p2(a,b,c) == ref) )
+		      nbLocalOk++;
+		    nbLocal++;
+#ifdef DEBUG_VERBOSE
+		    std::cout << a << b << c << " " << ref << std::endl;
+#endif
+		  }
+	      }
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Radius not fitting in a machine integer" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    BigInteger num2(1);
+    num2 <<= 100;
+    for (int sign = 0; sign < 2; sign++)
+      {
+	CircumcircleRadiusPredicate<BigInteger> p(num2, 1, (sign == 0));
+	for (int i = 0; i < 100; i++)
+	  {
+	    Point a( randomInteger(30), randomInteger(30) );
+	    Point b( a + Point( randomInteger(20), randomInteger(20) ) );
+	    Point c( b + (b - a) + Point( randomInteger(3), randomInteger(3) ) );
+	    if ( p(a,b,c) == referencePredicate(num2, BigInteger(1), (sign == 0), a, b, c) )
+	      nbLocalOk++;
+	    nbLocal++;
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Bounded evaluation against BigInteger evaluation" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    //differences less than 2^23, radius fraction less than 2^61
+    typedef CircumcircleRadiusTraits<23, 61> Traits; 
+    for (int l = 0; l <= 60; l += 4)
+      {
+	long long num2 = (1LL << l) + (rand()%16);
+	long long den2 = 1 + (rand()%3);
+	for (int sign = 0; sign < 2; sign++)
+	  {
+	    CircumcircleRadiusPredicate<long long, Traits> p(num2, den2, (sign == 0));
+	    for (int i = 0; i < 25; i++)
+	      {
+		Point a( randomInteger(40), randomInteger(40) );
+		Point b( a + Point( randomInteger(20), randomInteger(20) ) );
+		Point c( b + (b - a) + Point( randomInteger(3), randomInteger(3) ) );
+		if ( p(a,b,c) == referencePredicate(BigInteger( (long) num2 ), BigInteger( (long) den2 ),
+						    (sign == 0), a, b, c) )
+		  nbLocalOk++;
+		nbLocal++;
+	      }
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Radius out of the bounds of the traits" << std::endl;
+  {
+    typedef CircumcircleRadiusTraits<23, 61> Traits; 
+    long long num2[3] = {1LL << 61, 25, -1};
+    long long den2[3] = {1, 1LL << 62, 1};
+    for (int i = 0; i < 3; i++)
+      {
+	try {
+	  CircumcircleRadiusPredicate<long long, Traits> p(num2[i], den2[i]);
+	} catch (const std::out_of_range&) {
+	  nbok++;
+	}
+	nb++;
+      }
+    //largest bounded radius
+    long long maxNum2 = (1LL << 61) - 1;
+    CircumcircleRadiusPredicate<long long, Traits> p(maxNum2, 1);
+    Point a(0,0), b(1 << 22, 1), c( (1 << 23) - 1, 0 );
+    if ( p(a,b,c) == referencePredicate(BigInteger( (long) maxNum2 ), BigInteger(1), true, a, b, c) )
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Differences at the bounds of the traits" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    typedef CircumcircleRadiusTraits<23, 61> Traits; 
+    //largest differences: 2^23 - 1 in absolute value
+    long long m = (1LL << 23) - 1;
+    long long num2[3] = {1, 1LL << 46, (1LL << 61) - 1};
+    for (int k = 0; k < 3; k++)
+      for (int sign = 0; sign < 2; sign++)
+	{
+	  CircumcircleRadiusPredicate<long long, Traits> p(num2[k], 1, (sign == 0));
+	  for (int i = 0; i < 25; i++)
+	    {
+	      int s = (i%2 == 0)?1:-1;
+	      Point a( randomInteger(40), randomInteger(40) );
+	      Point b( a + Point( s*m, s*(rand()%(m+1)) ) );
+	      Point c( a + Point( s*(rand()%(m+1)), s*m ) );
+	      if ( p(a,b,c) == referencePredicate(BigInteger( (long) num2[k] ), BigInteger(1),
+						  (sign == 0), a, b, c) )
+		nbLocalOk++;
+	      nbLocal++;
+	    }
+	}
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Products not fitting in 128-bit integers" << std::endl;
+  {
+    int nbLocalOk = 0, nbLocal = 0;
+    for (int sign = 0; sign < 2; sign++)
+      {
+	long long num2 = (1LL << 60) + (rand()%16);
+	long long den2 = (1LL << 20) + (rand()%16);
+	CircumcircleRadiusPredicate<long long> p(num2, den2, (sign == 0));
+	for (int i = 0; i < 100; i++)
+	  {
+	    //squared lengths of about 2^50
+	    Point a( randomInteger(30), randomInteger(30) );
+	    Point b( a + Point( randomInteger(25), randomInteger(25) ) );
+	    Point c( b + (b - a) + Point( randomInteger(12), randomInteger(12) ) );
+	    if ( p(a,b,c) == referencePredicate(BigInteger( (long) num2 ), BigInteger( (long) den2 ),
+						(sign == 0), a, b, c) )
+	      nbLocalOk++;
+	    nbLocal++;
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "Degenerated cases" << std::endl;
+  {
+    //infinite radius
+    CircumcircleRadiusPredicate<long long> p;
+    //collinear points
+    if ( p( Point(0,0), Point(1,1), Point(2,2) ) == true )
+      nbok++;
+    nb++;
+    CircumcircleRadiusPredicate<long long> p2(25, 1, false);
+    if ( p2( Point(0,0), Point(1,1), Point(2,2) ) == false )
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
@@ -1,7 +1,9 @@
 #include <iostream>
+#include <sstream>
 //containers and iterators
 #include <iterator>
 #include <vector>
+#include <algorithm>
 #include <deque>
 // random
 #include <cstdlib>
@@ -10,6 +12,7 @@
 #include "../inc/PointVector2D.h"
 // Circle
 #include "../inc/ExactRayIntersectableCircle.h"
+#include "../inc/FilteredRayIntersectableCircle.h"
 // Convex Hull
 #include "../inc/OutputSensitiveConvexHull.h"
 #include "../inc/ConvexHullHelpers.h"
@@ -24,6 +27,43 @@ void convexHull(const Shape& aShape, OutputIterator res, bool aVertOnEdges)
   ch.all(res, aVertOnEdges);
 }
 
+/**
+ * Brute-force retrieval of the vertices of a convex hull
+ * whose outward normals lie in the angular sector going
+ * counter-clockwise from @a aFrom to @a aTo
+ */
+template <typename Point>
+void sectorOfHull(const std::vector<Point>& aHull, const Point& aFrom, const Point& aTo, 
+		  std::vector<Point>& res)
+{
+  int n = aHull.size(); 
+  long long maxFrom = aFrom.dot(aHull[0]), maxTo = aTo.dot(aHull[0]); 
+  for (int i = 1; i < n; i++)
+    {
+      maxFrom = std::max(maxFrom, (long long) aFrom.dot(aHull[i])); 
+      maxTo = std::max(maxTo, (long long) aTo.dot(aHull[i])); 
+    }
+  //first vertex supporting aFrom and last vertex supporting aTo
+  int first = 0, last = 0; 
+  for (int i = 0; i < n; i++)
+    {
+      if ( (aFrom.dot(aHull[i]) == maxFrom) && (aFrom.dot(aHull[(i+n-1)%n]) != maxFrom) )
+	first = i; 
+      if ( (aTo.dot(aHull[i]) == maxTo) && (aTo.dot(aHull[(i+1)%n]) != maxTo) )
+	last = i; 
+    }
+  int i = first; 
+  res.push_back(aHull[i]); 
+  bool isWhole = ( (first == last) && ( (long long) aFrom[0]*aTo[1] - (long long) aFrom[1]*aTo[0] < 0 ) ); 
+  if ( (first == last) && (!isWhole) )
+    return; 
+  for (i = (i+1)%n; (i != first); i = (i+1)%n)
+    {
+      res.push_back(aHull[i]); 
+      if (i == last)
+	return; 
+    }
+}
 
 ///////////////////////////////////////////////////////////////////////
 int main() 
@@ -221,6 +261,404 @@ int main()
 	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
       }
   }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "4 - Convex hull on random circles translated by 2^40" << std::endl; 
+#endif
+
+  {
+    typedef PointVector2D<long long> LongPoint; 
+    typedef ExactRayIntersectableCircle<LongPoint, DGtal::BigInteger> LongCircle;
+
+    const LongPoint t( (1LL << 40) + rand()%1000, (1LL << 40) - rand()%1000 ); 
+    for (int i = 0; i < 20; i++)
+      {
+	// random triangle with a counter-clockwise orientation
+	Point p, q, r; 
+	do {
+	  p = Point( rand()%maxRadius, rand()%maxRadius ); 
+	  q = Point( rand()%maxRadius, rand()%maxRadius ); 
+	  r = Point( rand()%maxRadius, rand()%maxRadius ); 
+	} while ( (q-p)[0]*(r-p)[1] - (q-p)[1]*(r-p)[0] <= 0 ); 
+
+	CircleBig circle(p, q, r); 
+	LongCircle translatedCircle( LongPoint(p[0], p[1]) + t, 
+				     LongPoint(q[0], q[1]) + t, 
+				     LongPoint(r[0], r[1]) + t ); 
+
+	std::vector<Point> v; 
+	convexHull( circle, std::back_inserter(v), false ); 
+	std::vector<LongPoint> tv; 
+	convexHull( translatedCircle, std::back_inserter(tv), false ); 
+
+	// once normalized, the parameters do not depend 
+	// on the translation and fit in machine integers
+	translatedCircle.normalize(); 
+	typedef IntegerTraits<DGtal::BigInteger> Traits; 
+	ExactRayIntersectableCircle<LongPoint> normalizedCircle( Traits::castToInt64(translatedCircle.a()), 
+								 Traits::castToInt64(translatedCircle.b()), 
+								 Traits::castToInt64(translatedCircle.c()), 
+								 Traits::castToInt64(translatedCircle.d()), 
+								 translatedCircle.getShift() ); 
+	std::vector<LongPoint> nv; 
+	convexHull( normalizedCircle, std::back_inserter(nv), false ); 
+
+#ifdef DEBUG_VERBOSE
+	std::copy(tv.begin(), tv.end(), std::ostream_iterator<LongPoint>(std::cout, ", ") ); 
+	std::cout << std::endl; 
+#endif
+
+	bool isOk = (v.size() == tv.size()) && (Traits::isInt64(translatedCircle.d()))
+	  && (nv.size() == tv.size()) && (std::equal(nv.begin(), nv.end(), tv.begin())); 
+	for (unsigned int j = 0; (isOk)&&(j < v.size()); j++)
+	  isOk = ( LongPoint(v[j][0], v[j][1]) + t == tv[j] ); 
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "5 - Convex hull on random filtered circles" << std::endl; 
+#endif
+
+  {
+    typedef FilteredRayIntersectableCircle<Circle> FilteredCircle; 
+
+    for (int i = 0; i < 50; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+
+	Circle circle( a, b, c, d );	
+	circle.normalize(); 
+	FilteredCircle filteredCircle( circle ); 
+
+	std::vector<Point> v; 
+	convexHull( circle, std::back_inserter(v), false ); 
+	std::vector<Point> fv; 
+	convexHull( filteredCircle, std::back_inserter(fv), false ); 
+
+#ifdef DEBUG_VERBOSE
+	std::cout << "filtered calls: " << filteredCircle.getNbFilteredCalls()
+		  << ", exact calls: " << filteredCircle.getNbExactCalls() << std::endl; 
+#endif
+
+	// same output, mostly computed with doubles
+	if ( (v.size() == fv.size()) && (std::equal(v.begin(), v.end(), fv.begin())) 
+	     && (filteredCircle.getNbFilteredCalls() > filteredCircle.getNbExactCalls()) )
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "6 - Convex hull on circles with compile-time bounds" << std::endl; 
+#endif
+
+  {
+    //radius less than 2^9 and |c| = 25 < 2^5: 64-bit values and 128-bit discriminants
+    typedef CircleTraits<9, 5> SmallTraits; 
+    typedef ExactRayIntersectableCircle<Point, SmallTraits::Parameter, SmallTraits> SmallCircle; 
+    //radius less than 2^40: 128-bit values and 256-bit discriminants
+    typedef CircleTraits<40, 5> LargeTraits; 
+    typedef ExactRayIntersectableCircle<Point, LargeTraits::Parameter, LargeTraits> LargeCircle; 
+
+    for (int i = 0; i < 20; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+
+	Circle circle( a, b, c, d );	
+	circle.normalize(); 
+	SmallCircle smallCircle( circle.a(), circle.b(), circle.c(), circle.d(), circle.getShift() ); 
+	LargeCircle largeCircle( circle.a(), circle.b(), circle.c(), circle.d(), circle.getShift() ); 
+
+	std::vector<Point> v, sv, lv; 
+	convexHull( circle, std::back_inserter(v), false ); 
+	convexHull( smallCircle, std::back_inserter(sv), false ); 
+	convexHull( largeCircle, std::back_inserter(lv), false ); 
+
+	if ( (v.size() == sv.size()) && (std::equal(v.begin(), v.end(), sv.begin())) 
+	     && (v.size() == lv.size()) && (std::equal(v.begin(), v.end(), lv.begin())) )
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "7 - Warm started against cold started searches" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );	
+
+	bool isOk = true; 
+	for (int vertOnEdges = 0; vertOnEdges < 2; vertOnEdges++)
+	  {
+	    //each vertex is searched from the previous edge
+	    std::vector<Point> v; 
+	    OutputSensitiveConvexHull<Circle> ch(circle); 
+	    ch.all( std::back_inserter(v), (vertOnEdges == 1) ); 
+
+	    //each vertex is searched from scratch
+	    std::vector<Point> cv; 
+	    Point p = circle.getConvexHullVertex(); 
+	    do {
+	      cv.push_back(p); 
+	      OutputSensitiveConvexHull<Circle> coldCh(circle); 
+	      p = coldCh.next(p, (vertOnEdges == 1)); 
+	    } while ( (p != cv.front()) && (cv.size() <= v.size()) ); 
+
+	    isOk = isOk && (v.size() == cv.size()) && (std::equal(v.begin(), v.end(), cv.begin())); 
+	  }
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "8 - Parallel against sequential retrieval" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );	
+
+	bool isOk = true; 
+	for (int vertOnEdges = 0; vertOnEdges < 2; vertOnEdges++)
+	  {
+	    std::vector<Point> v; 
+	    OutputSensitiveConvexHull<Circle> ch(circle); 
+	    ch.all( std::back_inserter(v), (vertOnEdges == 1) ); 
+	    //default, odd and large numbers of tasks
+	    unsigned int nbTasks[4] = { 0, 3, 8, 64 }; 
+	    for (int k = 0; k < 4; k++)
+	      {
+		std::vector<Point> pv; 
+		OutputSensitiveConvexHull<Circle> parallelCh(circle); 
+		parallelCh.parallelAll( std::back_inserter(pv), (vertOnEdges == 1), nbTasks[k] ); 
+
+		isOk = isOk && (v.size() == pv.size()) && (std::equal(v.begin(), v.end(), pv.begin())); 
+	      }
+	  }
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "9 - Symmetric against whole retrieval" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	//integer or half-integer center, 
+	//possibly lying on a diagonal
+	R = 1 + rand() % maxRadius;
+	a = - c * (rand() % 40); 
+	b = (i%2 == 0)?( -c * (rand() % 40) ):( a + 2*c*(rand() % 5) ); 
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );	
+
+	bool isOk = true; 
+	for (int vertOnEdges = 0; vertOnEdges < 2; vertOnEdges++)
+	  {
+	    std::vector<Point> v, sv; 
+	    OutputSensitiveConvexHull<Circle> ch(circle); 
+	    ch.setSymmetry(false); 
+	    ch.all( std::back_inserter(v), (vertOnEdges == 1) ); 
+	    OutputSensitiveConvexHull<Circle> symmetricCh(circle); 
+	    symmetricCh.all( std::back_inserter(sv), (vertOnEdges == 1) ); 
+
+	    isOk = isOk && (v.size() == sv.size()) && (std::equal(v.begin(), v.end(), sv.begin())); 
+
+	    //walk along the fundamental sector split into tasks
+	    unsigned int nbTasks[3] = { 2, 5, 64 }; 
+	    for (int k = 0; k < 3; k++)
+	      {
+		std::vector<Point> pv; 
+		OutputSensitiveConvexHull<Circle> parallelCh(circle); 
+		parallelCh.parallelAll( std::back_inserter(pv), (vertOnEdges == 1), nbTasks[k] ); 
+
+		isOk = isOk && (v.size() == pv.size()) && (std::equal(v.begin(), v.end(), pv.begin())); 
+	      }
+	  }
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "10 - Lazy range against whole retrieval" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );	
+
+	bool isOk = true; 
+	for (int vertOnEdges = 0; vertOnEdges < 2; vertOnEdges++)
+	  {
+	    std::vector<Point> v, lv; 
+	    OutputSensitiveConvexHull<Circle> ch(circle); 
+	    ch.all( std::back_inserter(v), (vertOnEdges == 1) ); 
+
+	    //whole range
+	    OutputSensitiveConvexHull<Circle> lazyCh(circle); 
+	    VertexRange<OutputSensitiveConvexHull<Circle> > range = lazyCh.vertices( (vertOnEdges == 1) ); 
+	    std::copy( range.begin(), range.end(), std::back_inserter(lv) ); 
+	    isOk = isOk && (v.size() == lv.size()) && (std::equal(v.begin(), v.end(), lv.begin())); 
+
+	    //prefix: vertices up to the first one of max x-coordinate
+	    std::vector<Point> pv; 
+	    OutputSensitiveConvexHull<Circle> prefixCh(circle); 
+	    VertexRange<OutputSensitiveConvexHull<Circle> > prefixRange = prefixCh.vertices( (vertOnEdges == 1) ); 
+	    VertexRange<OutputSensitiveConvexHull<Circle> >::ConstIterator it = prefixRange.begin(); 
+	    for ( ; (it != prefixRange.end()) && ( (pv.empty()) || ((*it)[0] >= pv.back()[0]) ); ++it)
+	      pv.push_back(*it); 
+	    isOk = isOk && (pv.size() < v.size()) && (std::equal(pv.begin(), pv.end(), v.begin())); 
+	  }
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "11 - Interrupted and resumed enumeration" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );	
+
+	bool isOk = true; 
+	for (int vertOnEdges = 0; vertOnEdges < 2; vertOnEdges++)
+	  {
+	    std::vector<Point> v, rv; 
+	    OutputSensitiveConvexHull<Circle> ch(circle); 
+	    ch.all( std::back_inserter(v), (vertOnEdges == 1) ); 
+
+	    //the state is saved and read by a new algorithm after each slice
+	    std::string token; 
+	    {
+	      OutputSensitiveConvexHull<Circle> firstCh(circle); 
+	      std::ostringstream out; 
+	      firstCh.start( (vertOnEdges == 1) ).write(out); 
+	      token = out.str(); 
+	    }
+	    bool isComplete = false; 
+	    while ( (!isComplete) && (rv.size() <= v.size()) )
+	      {
+		OutputSensitiveConvexHull<Circle> sliceCh(circle); 
+		OutputSensitiveConvexHull<Circle>::State state; 
+		std::istringstream in(token); 
+		isOk = isOk && state.read(in); 
+		isComplete = sliceCh.resume( state, std::back_inserter(rv), 1 + rand() % 10 ); 
+		std::ostringstream out; 
+		state.write(out); 
+		token = out.str(); 
+	      }
+	    isOk = isOk && (v.size() == rv.size()) && (std::equal(v.begin(), v.end(), rv.begin())); 
+	  }
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "12 - Angular sector against whole retrieval" << std::endl; 
+#endif
+
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	R = 1 + rand() % maxRadius;
+	a = - rand() %(2*c);
+	b = - rand() %(2*c);  
+	d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	CircleBig circle( a, b, c, d );	
+	std::vector<Point> v; 
+	OutputSensitiveConvexHull<CircleBig> ch(circle); 
+	ch.all( std::back_inserter(v) ); 
+
+	bool isOk = true; 
+	for (int j = 0; j < 20; j++)
+	  {
+	    //small and large directions
+	    int l = (j%2 == 0)?20:2000; 
+	    Vector from( rand()%(2*l+1) - l, rand()%(2*l+1) - l ); 
+	    Vector to( rand()%(2*l+1) - l, rand()%(2*l+1) - l ); 
+	    if (j%5 == 0)
+	      to = from; 
+	    if ( (from == Vector(0,0)) || (to == Vector(0,0)) )
+	      continue; 
+	    std::vector<Point> sv, rv, fromv, tov; 
+	    sectorOfHull(v, from, to, sv); 
+	    //vertices supporting a single direction
+	    sectorOfHull(v, from, from, fromv); 
+	    sectorOfHull(v, to, to, tov); 
+	    OutputSensitiveConvexHull<CircleBig> sectorCh(circle); 
+	    sectorCh.range( from, to, std::back_inserter(rv) ); 
+	    isOk = isOk && (circle.getSupportingVertex(from, false) == fromv.front())
+	      && (circle.getSupportingVertex(to) == tov.back())
+	      && (sv.size() == rv.size()) && (std::equal(sv.begin(), sv.end(), rv.begin())); 
+	  }
+	isOk = isOk && (circle.getSupportingVertex(Vector(0,-1)) == circle.getConvexHullVertex()); 
+	if (isOk)
+	  nbok++; 
+	nb++; 
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
   
   //1 if at least one test failed
   //0 otherwise
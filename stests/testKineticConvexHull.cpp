@@ -0,0 +1,153 @@
+#include <iostream>
+//containers and iterators
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <deque>
+// random
+#include <cstdlib>
+#include <ctime>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Circle
+#include "../inc/ExactRayIntersectableCircle.h"
+// Convex Hull
+#include "../inc/OutputSensitiveConvexHull.h"
+#include "../inc/KineticCircleConvexHull.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * @return 'true' if the vertices maintained by @a aKineticHull
+ * are the vertices of the convex hull of its current circle
+ */
+template <typename KineticHull>
+bool check(const KineticHull& aKineticHull)
+{
+  typedef typename KineticHull::Point Point;
+  typedef typename KineticHull::Circle Circle;
+  std::vector<Point> v, kv;
+  OutputSensitiveConvexHull<Circle> ch(aKineticHull.getCircle());
+  ch.all( std::back_inserter(v) );
+  aKineticHull.all( std::back_inserter(kv) );
+  return ( (v.size() == kv.size()) && (std::equal(v.begin(), v.end(), kv.begin()))
+	   && (aKineticHull.size() == v.size()) );
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<int> Point; //type redefinition
+  typedef ExactRayIntersectableCircle<Point,  DGtal::BigInteger> Circle;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "1 - Growing disc of center (0,0)" << std::endl;
+#endif
+  {
+    //radius from 10 to 50, ie. d from 100 to 2500
+    KineticCircleConvexHull<Circle> kch( Circle(0, 0, -1, 100) );
+    bool isOk = check(kch);
+    unsigned long long sum = kch.size();
+    for (int d = 101; d <= 2500; d++)
+      {
+	kch.setD(d);
+	sum += kch.size();
+	if (!check(kch))
+	  isOk = false;
+      }
+    if (isOk)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+    //the sweep is cheaper than the sum of the convex hull sizes
+#ifdef DEBUG_VERBOSE
+    std::cout << kch.getNbRetrievedVertices() << " retrieved vertices / "
+	      << sum << " vertices" << std::endl;
+#endif
+    if (kch.getNbRetrievedVertices() < sum)
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+    //shrinking disc
+    kch.setD(400);
+    if (check(kch))
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "2 - Growing discs of random centers" << std::endl;
+#endif
+  {
+    for (int i = 0; i < 20; i++)
+      {
+	//center of coordinates multiple of 1/4
+	int c = -2;
+	int R = 2 + rand() % 20;
+	int a = rand() % 800 - 400;
+	int b = rand() % 800 - 400;
+	int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	KineticCircleConvexHull<Circle> kch( Circle(a, b, c, d) );
+	bool isOk = check(kch);
+	for (int j = 0; j < 100; j++)
+	  {
+	    d += rand() % 20;
+	    kch.setD(d);
+	    if (!check(kch))
+	      isOk = false;
+	  }
+	if (isOk)
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "3 - Moving discs" << std::endl;
+#endif
+  {
+    for (int i = 0; i < 20; i++)
+      {
+	//steps of 1/16 pixel
+	int c = -8;
+	int R = 2 + rand() % 50;
+	int a = rand() % 800 - 400;
+	int b = rand() % 800 - 400;
+	int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	KineticCircleConvexHull<Circle> kch( Circle(a, b, c, d) );
+	bool isOk = check(kch);
+	unsigned long long sum = kch.size();
+	for (int j = 0; j < 50; j++)
+	  {
+	    a += rand() % 7 - 3;
+	    b += rand() % 7 - 3;
+	    d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	    kch.setParameters(a, b, d);
+	    sum += kch.size();
+	    if (!check(kch))
+	      isOk = false;
+	  }
+	if ( (isOk) && (kch.getNbRetrievedVertices() < sum) )
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
@@ -0,0 +1,127 @@
+#include <iostream>
+//containers and iterators
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <deque>
+// random
+#include <cstdlib>
+#include <ctime>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Circle
+#include "../inc/ExactRayIntersectableCircle.h"
+#include "../inc/FilteredRayIntersectableCircle.h"
+// Alpha-shape
+#include "../inc/IncrementalNegativeAlphaShape.h"
+#include "../inc/MultiNegativeAlphaShape.h"
+#include "../inc/CircumcircleRadiusPredicate.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * @return 'true' if the alpha-shapes retrieved at once are equal
+ * to the ones retrieved one by one, with fewer calls to the circle
+ * (sign evaluations and ray castings, counted by a filtered circle)
+ */
+template <typename Exact, typename Predicate>
+bool test(const Exact& aCircle, const std::vector<Predicate>& aPredicates, bool aIsSymmetric)
+{
+  typedef FilteredRayIntersectableCircle<Exact> Circle;
+  typedef typename Circle::Point Point;
+  Circle circle(aCircle);
+
+  std::vector<std::vector<Point> > v( aPredicates.size() );
+  std::vector<std::back_insert_iterator<std::vector<Point> > > res;
+  for (unsigned int i = 0; i < v.size(); i++)
+    res.push_back( std::back_inserter(v[i]) );
+  MultiNegativeAlphaShape<Circle, Predicate> mas(circle, aPredicates);
+  mas.setSymmetry(aIsSymmetric);
+  mas.all(res);
+  unsigned long long nbCalls = circle.getNbFilteredCalls() + circle.getNbExactCalls();
+
+  bool isOk = true;
+  unsigned long long sum = 0;
+  for (unsigned int i = 0; i < aPredicates.size(); i++)
+    {
+      std::vector<Point> w;
+      circle.resetCounters();
+      IncrementalNegativeAlphaShape<Circle, Predicate> as(circle, aPredicates[i]);
+      as.setSymmetry(aIsSymmetric);
+      as.all( std::back_inserter(w) );
+      sum += circle.getNbFilteredCalls() + circle.getNbExactCalls();
+      if ( (v[i].size() != w.size()) || (!std::equal(w.begin(), w.end(), v[i].begin())) )
+	isOk = false;
+    }
+#ifdef DEBUG_VERBOSE
+  std::cout << nbCalls << " calls / " << sum << std::endl;
+#endif
+  return ( (isOk) && (nbCalls < sum) );
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<int> Point; //type redefinition
+  typedef ExactRayIntersectableCircle<Point,  DGtal::BigInteger> Circle;
+  typedef CircumcircleRadiusPredicate<> Predicate;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+  //increasing radii, the last one being infinite
+  int nbPredicate = 10;
+  int valuePredicateNum[10] = {4, 10, 20, 200, 2000, 20000, 100000, 200000, 2000000, 3};
+  int valuePredicateDen[10] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 0};
+  std::vector<Predicate> predicates;
+  for (int i = 0; i < nbPredicate; i++)
+    predicates.push_back( Predicate(valuePredicateNum[i], valuePredicateDen[i], false) );
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "1 - Circles through three random points" << std::endl;
+#endif
+  {
+    int maxPoint = 100;
+    for (int i = 0; i < 20; i++)
+      {
+	Point pta( (rand() % maxPoint), (rand() % maxPoint) );
+	Point ptb( (pta[0]-1- (rand() % maxPoint) ), (pta[1]-1- (rand() % maxPoint)) );
+	Point ptc( (ptb[0]+1+ (rand() % maxPoint) ), (ptb[1]-1- (rand() % maxPoint)) );
+	Circle circle( pta, ptb, ptc );
+	circle.normalize();
+	if (test(circle, predicates, false))
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "2 - Circles of integer or half-integer centers" << std::endl;
+#endif
+  {
+    for (int i = 0; i < 10; i++)
+      {
+	//the center (-a/2c, -b/2c) has integer or half-integer coordinates
+	int c = -2;
+	int a = -c * (rand() % 100);
+	int b = -c * (rand() % 100);
+	int R = 2 + rand() % 100;
+	int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	Circle circle( a, b, c, d );
+	if (test(circle, predicates, true))
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
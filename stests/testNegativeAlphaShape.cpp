@@ -15,6 +15,7 @@
 #include "../inc/PointVector2D.h"
 // Circle
 #include "../inc/ExactRayIntersectableCircle.h"
+#include "../inc/FilteredRayIntersectableCircle.h"
 // Convex Hull
 
 #include "../inc/OutputSensitiveConvexHull.h"
@@ -450,6 +451,10 @@ int main()
       ptc = Point( (ptb[0]+1+ (rand() % maxPoint) ), (ptb[1]-1- (rand() % maxPoint)) );
 
       Circle circle( pta, ptb, ptc );
+      //same circle with normalized parameters and its filtered version
+      Circle normalizedCircle( circle ); 
+      normalizedCircle.normalize(); 
+      FilteredRayIntersectableCircle<Circle> filteredCircle( normalizedCircle ); 
 
       #ifdef DEBUG_VERBOSE
       std::cout << "II - "<<nb_test<<" - Alpha-shape on the circle : " << std::endl; 
@@ -480,6 +485,20 @@ int main()
           nb++; 
 	  
           std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+          //same alpha-shape with the normalized circle
+          if (test(normalizedCircle, predicate))
+            nbok++;
+          nb++; 
+	  
+          std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+          //same alpha-shape with the filtered circle
+          if (test(filteredCircle, predicate))
+            nbok++;
+          nb++; 
+	  
+          std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
         }
       }
 
@@ -516,6 +535,61 @@ int main()
 
     std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
   }
+
+  #ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "III) Alpha-shape on circles of integer or half-integer centers" << std::endl << std::endl; 
+  #endif
+
+  for (int i = 0; i < 10; i++)
+  {
+    //the center (-a/2c, -b/2c) has integer or half-integer coordinates
+    int c = -2; 
+    int a = -c * (rand() % maxPoint); 
+    int b = -c * (rand() % maxPoint); 
+    int R = 2 + rand() % maxPoint; 
+    int d = ( a*a + b*b - 4*R*R*c*c)/(4*c); 
+    Circle circle( a, b, c, d ); 
+
+    #ifdef DEBUG_VERBOSE
+    std::cout << "-- Disk[ Center : (" << circle.getCenterX() << ", " 
+      << circle.getCenterY()<< " ), Radius : " << circle.getRadius() << " ]" << std::endl;
+    #endif
+
+    for (int j = 0; j < nbPredicate; j += 2)
+    {
+      CircumcircleRadiusPredicate<> predicate(valuePredicateNum[j], valuePredicateDen[j],false);
+      if (test(circle, predicate))
+        nbok++;
+      nb++; 
+      std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+    }
+  }
+
+  #ifdef DEBUG_VERBOSE
+  std::cout << std::endl; 
+  std::cout << "IV) Lazy range of the alpha-shape" << std::endl << std::endl; 
+  #endif
+
+  for (int i = 0; i < nbPredicate; i++)
+  {
+    Circle circle( Point(50,-3), Point(-20,41), Point(-33,-17) ); 
+    circle.normalize(); 
+    CircumcircleRadiusPredicate<> predicate(valuePredicateNum[i], valuePredicateDen[i],false);
+
+    std::vector<Point> v, lv; 
+    IncrementalNegativeAlphaShape<Circle, CircumcircleRadiusPredicate<> > as(circle, predicate); 
+    as.all( std::back_inserter(v) ); 
+    IncrementalNegativeAlphaShape<Circle, CircumcircleRadiusPredicate<> > lazyAs(circle, predicate); 
+    VertexRange<IncrementalNegativeAlphaShape<Circle, CircumcircleRadiusPredicate<> > > range = lazyAs.vertices(); 
+    std::copy( range.begin(), range.end(), std::back_inserter(lv) ); 
+
+    if ( (v.size() == lv.size()) && (std::equal(v.begin(), v.end(), lv.begin())) )
+      nbok++;
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
   //(4,2)(2,1)(6,-5) - (4,2)(0,-6)(10,-14) - (7,8)(-1,-1)(3,-8) - (5,3)(2,2)(4,-7)
   /*{
   
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <math.h>
+#include <type_traits>
 // Core geometry
 #include "../inc/PointVector2D.h"
 
@@ -56,6 +57,28 @@ int main()
     std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl; 
   }
 
+  std::cout << "Compound and fused operators" << std::endl; 
+  {
+    Point p(5,18); 
+    Point q(1,2);
+    Point s = p; 
+    (s += q) -= q; //chained compound operators
+    s.addScaled(q, 3); 
+
+    if ( ( s == p + q*3 ) && ( p.plusScaled(q, 3) == s ) ) 
+      nbok++; 
+    nb++;  
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl; 
+
+    //compile-time constants, copied as raw memory
+    constexpr Point c(3,4); 
+    static_assert( c.plusScaled(Point(1,1), 2) == Point(5,6), "constexpr PointVector2D" ); 
+    if ( std::is_trivially_copyable<Point>::value ) 
+      nbok++; 
+    nb++;  
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl; 
+  }
+
   std::cout << "Norms " << std::endl; 
   {
     Point p(5,18); 
@@ -6,6 +6,7 @@
 #include <iterator>
 #include <vector>
 #include <deque>
+#include <algorithm>
 // random
 #include <cstdlib>
 #include <ctime>
@@ -141,6 +142,41 @@ bool test(const Circle aCircle, const CircumcircleRadiusPredicate& aPredicate, c
 }
 
 
+///////////////////////////////////////////////////////////////////////
+/**
+ * @brief Procedure that checks whether the streaming
+ * algorithm returns the same alpha-shape as a Graham scan
+ * over the whole convex hull, which ends with the
+ * wrap-around update at the starting point. 
+ * 
+ * @param aCircle
+ * @param aPredicate  
+ * @param aStart any vertex of the convex hull
+ * 
+ * @return 'true' if the test passed, 'false' otherwise
+ */
+  template<typename Circle, typename CircumcircleRadiusPredicate, typename Point>
+bool testStream(const Circle& aCircle, const CircumcircleRadiusPredicate& aPredicate, const Point& aStart)
+{
+  // Materialized convex hull
+  std::vector<Point> v; 
+  convexHull( aCircle, aStart, std::back_inserter(v) ); 
+  std::vector<Point> ch0; 
+  closedGrahamScan( v.begin(), v.end(), std::back_inserter(ch0), aPredicate ); 
+
+  // Streamed alpha-shape
+  std::vector<Point> ch1; 
+  BottomUpPositiveAlphaShape<Circle, CircumcircleRadiusPredicate> as(aCircle, aPredicate);
+  as.all( aStart, std::back_inserter(ch1) ); 
+
+#ifdef DEBUG_VERBOSE
+  std::cout << v.size() << " convex hull vertices, " << ch1.size() 
+	    << " / " << ch0.size() << " alpha-shape vertices" << std::endl; 
+#endif
+
+  return ( (ch0.size() == ch1.size()) && (std::equal(ch0.begin(), ch0.end(), ch1.begin())) ); 
+}
+
 ///////////////////////////////////////////////////////////////////////
 int main() 
 {
@@ -284,6 +320,59 @@ int main()
   }  
 
 
+#ifdef DEBUG_VERBOSE
+  std::cout << " #3 -  Streaming against the materialized convex hull " << std::endl;
+#endif
+  {
+    for (int k = 1; k <= 20; k++)
+    {
+      pta = Point( (rand() % maxPoint)             , (rand() % maxPoint) );
+      ptb = Point( (pta[0]-1- (rand() % maxPoint) ), (pta[1]-1- (rand() % maxPoint)) );
+      ptc = Point( (ptb[0]+1+ (rand() % maxPoint) ), (ptb[1]-1- (rand() % maxPoint)) );
+      Circle circle( pta, ptb, ptc );
+      int Rint = ceil(circle.getRadius());
+
+      //starting points: the lowest vertex, a point of the 
+      //circle and any vertex, so that the wrap-around occurs
+      //anywhere
+      std::vector<Point> v; 
+      convexHull( circle, circle.getConvexHullVertex(), std::back_inserter(v) ); 
+      std::vector<Point> starts; 
+      starts.push_back( v[0] ); 
+      starts.push_back( pta ); 
+      starts.push_back( v[ rand() % v.size() ] ); 
+
+      bool isOk = true; 
+      for (unsigned int i = 0; i < starts.size(); i++)
+      {
+        //radii smaller and larger than the circle one, infinite radius
+        CircumcircleRadiusPredicate<> p1(Rint*Rint/4, 1), p2(Rint*Rint + 2*Rint, 1), 
+          p3(100*Rint*Rint, 1), p4; 
+        if ( !( testStream(circle, p1, starts[i]) && testStream(circle, p2, starts[i]) 
+                && testStream(circle, p3, starts[i]) && testStream(circle, p4, starts[i]) ) )
+          isOk = false; 
+      }
+      if (isOk)
+        nbok++;
+      nb++; 
+
+      std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+    }
+
+    //small convex hulls
+    for (int R = 1; R <= 4; R++)
+    {
+      Circle circle( 0, 0, -1, R*R ); 
+      CircumcircleRadiusPredicate<> p1(R*R, 1), p2(2*R*R, 1), p3; 
+      Point start = circle.getConvexHullVertex(); 
+      if (testStream(circle, p1, start) && testStream(circle, p2, start) 
+          && testStream(circle, p3, start))
+        nbok++; 
+      nb++; 
+      std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+    }
+  }
+
   //1 if at least one test failed
   //0 otherwise
   return (nb != nbok); 
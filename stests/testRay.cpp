@@ -1,5 +1,8 @@
 #include <iostream>
 #include <math.h>
+// random
+#include <cstdlib>
+#include <ctime>
 // Core geometry
 #include "../inc/PointVector2D.h"
 // Straight-line and circle
@@ -251,6 +254,119 @@ int main()
         nbok++; 
     nb++; 
     std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+    //the lowest point lies on the circle, 
+    //below and to the left of the center
+    Circle circle5(-26, -7, -25, 17); 
+    if ( (circle5.getConvexHullVertex() == Point(-1,-1))&&(circle5.getBottom() == -1) )
+        nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+    //the lowest row intersecting the circle 
+    //(center (0.5,0.9), radius 1) does not contain any digital point
+    Circle circle6(50, 90, -50, -3); 
+    if ( (circle6.getConvexHullVertex() == Point(1,1))&&(circle6.getBottom() == 1) )
+        nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+
+    /////////////////////////////////////////////////////////////// 
+    // supporting vertices of the convex hull
+    std::cout << "supporting vertices of the convex hull" << std::endl; 
+    if ( (circle.getSupportingVertex(Vector(0,-1)) == circle.getConvexHullVertex())
+	 && (circle.getSupportingVertex(Vector(3,0)) == Point(5,0)) 
+	 && (circle.getSupportingVertex(Vector(-1,-2)) == Point(-3,-4)) )
+        nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+    //edge from (4,3) to (3,4) and long direction
+    if ( (circle.getSupportingVertex(Vector(1,1)) == Point(3,4))
+	 && (circle.getSupportingVertex(Vector(1,1), false) == Point(4,3)) 
+	 && (circle.getSupportingVertex(Vector(1000001,999999)) == Point(4,3)) )
+        nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "testRayIntersectableCircle: random rays against a linear search" << std::endl; 
+  {
+    typedef ExactRayIntersectableCircle<Point> Circle; 
+    srand ( time(NULL) );
+    int nbLocalOk = 0, nbLocal = 0; 
+    for (int i = 0; i < 100; i++)
+      {
+	// random circle of counter-clockwise orientation
+	Point p( rand()%50, rand()%50 ), q( rand()%50, rand()%50 ), r( rand()%50, rand()%50 ); 
+	if ( (q-p)[0]*(r-p)[1] - (q-p)[1]*(r-p)[0] <= 0 )
+	  continue; 
+	Circle circle(p, q, r); 
+	for (int j = 0; j < 100; j++)
+	  {
+	    Point s( rand()%100 - 25, rand()%100 - 25 ); 
+	    Vector dir( rand()%9 - 4, rand()%9 - 4 ); 
+	    if (dir == Vector(0,0))
+	      continue; 
+	    // expected quotient: 0 if s is on the circle, otherwise 
+	    // last point of the same side before the first point 
+	    // lying on the other side (a point on the circle is kept)
+	    int k = 0; 
+	    bool isExpected = true; 
+	    if (circle(s) > 0)
+	      {
+		while (circle(s + dir*(k+1)) >= 0)
+		  k++; 
+	      }
+	    else if (circle(s) < 0)
+	      {
+		while ( (k < 500) && (circle(s + dir*k) < 0) )
+		  k++; 
+		if (k == 500)
+		  isExpected = false; 
+		else if (circle(s + dir*k) > 0)
+		  k--; 
+	      }
+	    int qMax = 0; 
+	    Point ptMax(0,0); 
+	    bool res = circle.dray(s, dir, qMax, ptMax); 
+	    if ( (res == isExpected) && ( (!res) || ( (qMax == k) && (ptMax == s + dir*k) ) ) )
+	      nbLocalOk++; 
+	    nbLocal++; 
+	  }
+      }
+    if (nbLocalOk == nbLocal)
+      nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+  std::cout << "ray cursors against the function" << std::endl; 
+  {
+    typedef ExactRayIntersectableCircle<Point> Circle; 
+    typedef RayIntersectableStraightLine<Point> SL; 
+    Circle circle( Point(6,1), Point(1,6), Point(-4,1) ); 
+    SL line( Point(1,1), Point(9,6) ); 
+    bool isOk = true; 
+    for (int i = 0; i < 100; i++)
+      {
+	Point s( rand()%20 - 10, rand()%20 - 10 ); 
+	Vector dir( rand()%9 - 4, rand()%9 - 4 ); 
+	Circle::RayCursor c1 = circle.cursor(s, dir); 
+	SL::RayCursor c2 = line.cursor(s, dir); 
+	for (int k = 0; k < 20; k++)
+	  {
+	    Point p = s + dir*k; 
+	    if ( (c1.point() != p) || (c1.value() != circle(p)) || (c1.nextValue() != circle(p + dir))
+		 || (c2.point() != p) || (c2.value() != line(p)) || (c2.nextValue() != line(p + dir)) )
+	      isOk = false; 
+	    c1.advance(); 
+	    c2.advance(); 
+	  }
+      }
+    if (isOk)
+      nbok++; 
+    nb++; 
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
   }
 
   //1 if at least one test failed
@@ -0,0 +1,206 @@
+#include <iostream>
+//containers and iterators
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <deque>
+// random
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+// Core geometry
+#include "../inc/PointVector2D.h"
+// Circle
+#include "../inc/ExactRayIntersectableCircle.h"
+// Convex Hull
+#include "../inc/OutputSensitiveConvexHull.h"
+#include "../inc/OutputSensitiveUnionConvexHull.h"
+
+//uncomment to use in DEBUG_VERBOSE mode
+//#define DEBUG_VERBOSE
+
+/**
+ * Union of the convex hulls of the shapes, computed as a whole,
+ * by a monotone chain over all their vertices
+ * (in a counter-clockwise order, from the vertex of minimal
+ * y-coordinate and maximal x-coordinate among them)
+ */
+template <typename Shape, typename Point>
+void unionConvexHull(const std::vector<Shape>& aShapes, std::vector<Point>& res)
+{
+  std::vector<Point> v;
+  for (unsigned int i = 0; i < aShapes.size(); i++)
+    {
+      //the walk does not end on a single point
+      Point p = aShapes[i].getSupportingVertex(Point(0,-1));
+      if ( (aShapes[i].getSupportingVertex(Point(1,0)) == p)
+	   && (aShapes[i].getSupportingVertex(Point(0,1)) == p)
+	   && (aShapes[i].getSupportingVertex(Point(-1,0)) == p) )
+	v.push_back(p);
+      else
+	{
+	  OutputSensitiveConvexHull<Shape> ch(aShapes[i]);
+	  ch.all( std::back_inserter(v) );
+	}
+    }
+  std::sort(v.begin(), v.end(), [](const Point& p, const Point& q)
+	    { return ( (p[0] < q[0]) || ( (p[0] == q[0]) && (p[1] < q[1]) ) ); } );
+  v.erase( std::unique(v.begin(), v.end()), v.end() );
+
+  std::vector<Point> h;
+  for (int pass = 0; pass < 2; pass++)
+    {
+      std::size_t start = h.size();
+      for (unsigned int i = 0; i < v.size(); i++)
+	{
+	  const Point& p = (pass == 0)?v[i]:v[v.size()-1-i];
+	  while ( (h.size() >= start + 2)
+		  && ( (long long) (h[h.size()-1][0] - h[h.size()-2][0]) * (p[1] - h[h.size()-2][1])
+		       - (long long) (h[h.size()-1][1] - h[h.size()-2][1]) * (p[0] - h[h.size()-2][0]) <= 0 ) )
+	    h.pop_back();
+	  h.push_back(p);
+	}
+      h.pop_back();
+    }
+  std::size_t first = 0;
+  for (std::size_t i = 1; i < h.size(); i++)
+    if ( (h[i][1] < h[first][1]) || ( (h[i][1] == h[first][1]) && (h[i][0] > h[first][0]) ) )
+      first = i;
+  std::rotate(h.begin(), h.begin() + first, h.end());
+  res = h;
+}
+
+///////////////////////////////////////////////////////////////////////
+int main()
+{
+  typedef PointVector2D<int> Point; //type redefinition
+  typedef ExactRayIntersectableCircle<Point,  DGtal::BigInteger> Circle;
+
+  int nbok = 0; //number of tests ok
+  int nb = 0;   //total number of tests
+
+  srand ( time(NULL) );
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "1 - Inner discs" << std::endl;
+#endif
+  {
+    //circle of center (0,0) and radius 100
+    //and circles of radius 10 inside it
+    std::vector<Circle> circles;
+    circles.push_back( Circle(0, 0, -1, 10000) );
+    //the distance between the centers is less than 71
+    for (int i = 0; i < 10; i++)
+      {
+	int x = rand()%100 - 50, y = rand()%100 - 50;
+	circles.push_back( Circle( 2*x, 2*y, -1, 100 - x*x - y*y ) );
+      }
+    std::vector<Point> v, uv;
+    unionConvexHull(circles, v);
+    OutputSensitiveUnionConvexHull<Circle> uch(circles);
+    uch.all( std::back_inserter(uv) );
+    if ( (v.size() == uv.size()) && (std::equal(v.begin(), v.end(), uv.begin()))
+	 && (uch.getBoundaryShapes().size() == 1) )
+      nbok++;
+    nb++;
+    std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "2 - Random discs" << std::endl;
+#endif
+  {
+    for (int i = 0; i < 20; i++)
+      {
+	//centers of coordinates multiple of 1/4
+	std::vector<Circle> circles;
+	int nbCircles = 1 + rand() % 30;
+	int c = -2;
+	for (int j = 0; j < nbCircles; j++)
+	  {
+	    int R = 1 + rand() % 50;
+	    int a = rand() % 800 - 400;
+	    int b = rand() % 800 - 400;
+	    int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	    circles.push_back( Circle(a, b, c, d) );
+	  }
+	std::vector<Point> v, uv;
+	unionConvexHull(circles, v);
+	OutputSensitiveUnionConvexHull<Circle> uch(circles);
+	uch.all( std::back_inserter(uv) );
+	if ( (v.size() == uv.size()) && (std::equal(v.begin(), v.end(), uv.begin())) )
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "3 - Small discs of aligned centers" << std::endl;
+#endif
+  {
+    //many collinear vertices and tangents 
+    //touching the discs at a vertex
+    for (int i = 0; i < 20; i++)
+      {
+	std::vector<Circle> circles;
+	int nbCircles = 1 + rand() % 30;
+	int c = -2;
+	for (int j = 0; j < nbCircles; j++)
+	  {
+	    int R = 1 + rand() % 3;
+	    int a = 8*(rand() % 10);
+	    int b = a/2 + 4*(rand() % 2);
+	    int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	    circles.push_back( Circle(a, b, c, d) );
+	  }
+	std::vector<Point> v, uv;
+	unionConvexHull(circles, v);
+	OutputSensitiveUnionConvexHull<Circle> uch(circles);
+	uch.all( std::back_inserter(uv) );
+	if ( (v.size() == uv.size()) && (std::equal(v.begin(), v.end(), uv.begin())) )
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+#ifdef DEBUG_VERBOSE
+  std::cout << std::endl;
+  std::cout << "4 - Many discs along a circle" << std::endl;
+#endif
+  {
+    //most discs contribute a chain, whose bridges
+    //are searched among the discs whose arcs are met
+    for (int i = 0; i < 5; i++)
+      {
+	std::vector<Circle> circles;
+	int nbCircles = 100 + rand() % 200;
+	int c = -2;
+	for (int j = 0; j < nbCircles; j++)
+	  {
+	    double t = 2 * M_PI * j / nbCircles;
+	    int R = 1 + rand() % 20;
+	    int a = (int) (8000 * std::cos(t)) + rand() % 4;
+	    int b = (int) (8000 * std::sin(t)) + rand() % 4;
+	    int d = ( a*a + b*b - 4*R*R*c*c)/(4*c);
+	    circles.push_back( Circle(a, b, c, d) );
+	  }
+	std::vector<Point> v, uv;
+	unionConvexHull(circles, v);
+	OutputSensitiveUnionConvexHull<Circle> uch(circles);
+	uch.all( std::back_inserter(uv) );
+	if ( (v.size() == uv.size()) && (std::equal(v.begin(), v.end(), uv.begin())) )
+	  nbok++;
+	nb++;
+	std::cout << "(" << nbok << " tests passed / " << nb << " tests)" << std::endl;
+      }
+  }
+
+  //1 if at least one test failed
+  //0 otherwise
+  return (nb != nbok);
+}
@@ -136,8 +136,8 @@ class OutputIteratorCounter:
 ///////////////////////////////////////////////////////////////////////// 
 
 
-  typedef PointVector2D<int> Point; //type redefinition
-  typedef PointVector2D<int> Vector; //type redefinition
+  typedef PointVector2D<long long> Point; //type redefinition
+  typedef PointVector2D<long long> Vector; //type redefinition
   typedef std::deque<Point> Container;
   typedef long long Integer;
 
@@ -342,6 +342,7 @@ void rToolMeans(int aHull, bool aTime, bool aEdgeVertices, int aFirstR, int aLas
 
       // Create a circle from the Euclidian parameter a, b, c, d.
       Circle circle( a, b, c, d );	
+      circle.normalize(); 
 
       // Test
       //std::cout<<"a = "<<a<<", b = "<<b<<", c = "<<c<<", d = "<<d<<std::endl;   